@@ -0,0 +1,247 @@
+/**
+ * @brief Throughput, latency percentiles and scaling of concurrent accesses to the settings, from 1 to N threads
+ * @details Each scenario runs a mix of reads and writes, all the threads sharing one file or each one using its own file:
+ *          - reads:            the writes are plain element writes
+ *          - transactions:     the writes are transactions of two element writes
+ *          - linked:           the reads are loads of a Linked variable refreshed by the element writes
+ *          - backup_restore:   the writes are alternately backups and restores of the file
+ *          The results are written as CSV on the standard output, one line per measurement, to be compared between commits:
+ *          scenario,files,threads,read_percent,operations,ops_per_s,scaling,p50_ns,p99_ns,p999_ns
+ *          where scaling is the throughput relative to the one of a single thread.
+ *          Usage: benchmark_contention [max_threads (default: cores)] [duration_ms (default 200)] [read_percents (default 100,90,50)]
+ */
+#include "../src/include/EmbSettings.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#define CONTENTION_FILE(_n)                                                                                                     \
+    EMBSETTINGS_FILE(File##_n, JSON, "benchmark_contention_" #_n ".json")                                                       \
+    EMBSETTINGS_SCALAR(Value##_n, int, File##_n, "values.value", 0)                                                             \
+    EMBSETTINGS_SCALAR(Other##_n, int, File##_n, "values.other", 0)                                                             \
+    EMBSETTINGS_SCALAR(LinkedValue##_n, int, File##_n, "values.linked", 0)
+
+CONTENTION_FILE(0)  CONTENTION_FILE(1)  CONTENTION_FILE(2)  CONTENTION_FILE(3)
+CONTENTION_FILE(4)  CONTENTION_FILE(5)  CONTENTION_FILE(6)  CONTENTION_FILE(7)
+CONTENTION_FILE(8)  CONTENTION_FILE(9)  CONTENTION_FILE(10) CONTENTION_FILE(11)
+CONTENTION_FILE(12) CONTENTION_FILE(13) CONTENTION_FILE(14) CONTENTION_FILE(15)
+
+namespace {
+
+    /**
+     * @brief Operations on one of the benchmarked files
+     */
+    struct FileOperations {
+        char const* szPath{ nullptr };
+        int (*funcRead)(){ nullptr };
+        void (*funcWrite)(int){ nullptr };
+        void (*funcTransaction)(int){ nullptr };
+        void (*funcWriteLinked)(int){ nullptr };
+        void (*funcLink)(emb::settings::Linked<int>&){ nullptr };
+        bool (*funcBackup)(std::ostream&){ nullptr };
+        bool (*funcRestore)(std::istream&){ nullptr };
+    };
+
+#define CONTENTION_OPERATIONS(_n) FileOperations{                                                                               \
+        "benchmark_contention_" #_n ".json",                                                                                    \
+        [] { return Value##_n::read(); },                                                                                       \
+        [](int a_iValue) { Value##_n::write(a_iValue); },                                                                       \
+        [](int a_iValue) { File##_n::begin(); Value##_n::write(a_iValue); Other##_n::write(a_iValue); File##_n::commit(); },    \
+        [](int a_iValue) { LinkedValue##_n::write(a_iValue); },                                                                 \
+        [](emb::settings::Linked<int>& a_rVariable) { LinkedValue##_n::link(a_rVariable); },                                    \
+        [](std::ostream& a_rStream) { return File##_n::backup_to(a_rStream); },                                                 \
+        [](std::istream& a_rStream) { return File##_n::restore_from(a_rStream); },                                              \
+    }
+
+    std::array<FileOperations, 16> const s_aFiles{
+        CONTENTION_OPERATIONS(0),  CONTENTION_OPERATIONS(1),  CONTENTION_OPERATIONS(2),  CONTENTION_OPERATIONS(3),
+        CONTENTION_OPERATIONS(4),  CONTENTION_OPERATIONS(5),  CONTENTION_OPERATIONS(6),  CONTENTION_OPERATIONS(7),
+        CONTENTION_OPERATIONS(8),  CONTENTION_OPERATIONS(9),  CONTENTION_OPERATIONS(10), CONTENTION_OPERATIONS(11),
+        CONTENTION_OPERATIONS(12), CONTENTION_OPERATIONS(13), CONTENTION_OPERATIONS(14), CONTENTION_OPERATIONS(15),
+    };
+
+    std::array<emb::settings::Linked<int>, 16> s_aLinkedVariables{};
+
+    std::atomic<long long> s_llChecksum{ 0 };
+
+    enum class Scenario { Reads, Transactions, Linked, BackupRestore };
+
+    char const* str(Scenario a_eScenario) {
+        switch(a_eScenario) {
+        case Scenario::Reads: return "reads";
+        case Scenario::Transactions: return "transactions";
+        case Scenario::Linked: return "linked";
+        case Scenario::BackupRestore: return "backup_restore";
+        }
+        return "?";
+    }
+
+    struct Run {
+        Scenario eScenario{};
+        bool bManyFiles{ false };           ///< Each thread uses its own file, instead of all the threads sharing the first one
+        std::size_t uThreadsCount{ 1 };
+        unsigned uReadPercent{ 100 };
+        std::chrono::milliseconds duration{};
+    };
+
+    struct Result {
+        std::size_t uOperations{ 0 };
+        double dOperationsPerSecond{ 0 };
+        std::chrono::nanoseconds p50{};
+        std::chrono::nanoseconds p99{};
+        std::chrono::nanoseconds p999{};
+    };
+
+    /**
+     * @brief Operations of one thread until the run is stopped, with the latency of each one
+     */
+    void run_thread(Run const& a_stRun, std::size_t a_uThread, std::atomic<bool> const& a_bStarted, std::atomic<bool> const& a_bStopped,
+                    std::vector<std::chrono::nanoseconds> & a_rvecLatencies) {
+        FileOperations const& stFile{ s_aFiles[a_stRun.bManyFiles ? a_uThread % s_aFiles.size() : 0] };
+        emb::settings::Linked<int> const& rLinked{ s_aLinkedVariables[a_stRun.bManyFiles ? a_uThread % s_aFiles.size() : 0] };
+        std::minstd_rand generator{ static_cast<std::minstd_rand::result_type>(a_uThread + 1) };
+        std::uniform_int_distribution<unsigned> percentDistribution{ 0, 99 };
+        std::string strBackup{};
+        long long llChecksum{ 0 };
+        int iValue{ 0 };
+        while(!a_bStarted.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        while(!a_bStopped.load(std::memory_order_relaxed)) {
+            bool const bRead{ percentDistribution(generator) < a_stRun.uReadPercent };
+            auto const start = std::chrono::steady_clock::now();
+            if(bRead) {
+                llChecksum += Scenario::Linked == a_stRun.eScenario ? rLinked.load() : stFile.funcRead();
+            }
+            else {
+                switch(a_stRun.eScenario) {
+                case Scenario::Reads:
+                    stFile.funcWrite(++iValue);
+                    break;
+                case Scenario::Transactions:
+                    stFile.funcTransaction(++iValue);
+                    break;
+                case Scenario::Linked:
+                    stFile.funcWriteLinked(++iValue);
+                    break;
+                case Scenario::BackupRestore:
+                    if(strBackup.empty() || 0 == ++iValue % 2) {
+                        std::ostringstream streamBackup{};
+                        stFile.funcBackup(streamBackup);
+                        strBackup = streamBackup.str();
+                    }
+                    else {
+                        std::istringstream streamBackup{ strBackup };
+                        stFile.funcRestore(streamBackup);
+                    }
+                    break;
+                }
+            }
+            a_rvecLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        s_llChecksum += llChecksum;
+    }
+
+    Result run(Run const& a_stRun) {
+        std::atomic<bool> bStarted{ false };
+        std::atomic<bool> bStopped{ false };
+        std::vector<std::vector<std::chrono::nanoseconds>> vecLatencies(a_stRun.uThreadsCount);
+        std::vector<std::thread> vecThreads{};
+        for(std::size_t uThread = 0; uThread < a_stRun.uThreadsCount; ++uThread) {
+            vecLatencies[uThread].reserve(1 << 20);
+            vecThreads.emplace_back(run_thread, std::cref(a_stRun), uThread, std::cref(bStarted), std::cref(bStopped), std::ref(vecLatencies[uThread]));
+        }
+        auto const start = std::chrono::steady_clock::now();
+        bStarted.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(a_stRun.duration);
+        bStopped = true;
+        for(auto & thread : vecThreads) {
+            thread.join();
+        }
+        auto const stop = std::chrono::steady_clock::now();
+
+        std::vector<std::chrono::nanoseconds> vecAllLatencies{};
+        for(auto const& vecThreadLatencies : vecLatencies) {
+            vecAllLatencies.insert(vecAllLatencies.end(), vecThreadLatencies.begin(), vecThreadLatencies.end());
+        }
+        Result stResult{};
+        stResult.uOperations = vecAllLatencies.size();
+        stResult.dOperationsPerSecond = stResult.uOperations / std::chrono::duration<double>(stop - start).count();
+        auto const percentile = [&vecAllLatencies](double a_dRank) {
+            if(vecAllLatencies.empty()) {
+                return std::chrono::nanoseconds{};
+            }
+            auto const it = vecAllLatencies.begin() + static_cast<std::ptrdiff_t>(a_dRank * (vecAllLatencies.size() - 1));
+            std::nth_element(vecAllLatencies.begin(), it, vecAllLatencies.end());
+            return *it;
+        };
+        stResult.p50 = percentile(0.5);
+        stResult.p99 = percentile(0.99);
+        stResult.p999 = percentile(0.999);
+        return stResult;
+    }
+
+    std::vector<unsigned> parse_percents(std::string const& a_strPercents) {
+        std::vector<unsigned> vecPercents{};
+        std::istringstream streamPercents{ a_strPercents };
+        for(std::string strPercent; std::getline(streamPercents, strPercent, ',');) {
+            vecPercents.push_back(std::min(100u, static_cast<unsigned>(std::strtoul(strPercent.c_str(), nullptr, 10))));
+        }
+        return vecPercents;
+    }
+
+    void remove_files() {
+        for(auto const& stFile : s_aFiles) {
+            std::remove(stFile.szPath);
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t const uMaxThreadsCount{ std::max<std::size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::thread::hardware_concurrency()) };
+    std::chrono::milliseconds const duration{ argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 200 };
+    std::vector<unsigned> const vecReadPercents{ parse_percents(argc > 3 ? argv[3] : "100,90,50") };
+
+    remove_files();
+    for(std::size_t uFile = 0; uFile < s_aFiles.size(); ++uFile) {
+        s_aFiles[uFile].funcLink(s_aLinkedVariables[uFile]);
+        // Created and loaded before the measurements
+        s_aFiles[uFile].funcWrite(1);
+        s_aFiles[uFile].funcWriteLinked(1);
+    }
+
+    std::vector<std::size_t> vecThreadsCounts{};
+    for(std::size_t uThreadsCount = 1; uThreadsCount < uMaxThreadsCount; uThreadsCount *= 2) {
+        vecThreadsCounts.push_back(uThreadsCount);
+    }
+    vecThreadsCounts.push_back(uMaxThreadsCount);
+
+    std::cout << "scenario,files,threads,read_percent,operations,ops_per_s,scaling,p50_ns,p99_ns,p999_ns" << std::endl;
+    for(auto const eScenario : { Scenario::Reads, Scenario::Transactions, Scenario::Linked, Scenario::BackupRestore }) {
+        for(bool const bManyFiles : { false, true }) {
+            for(unsigned const uReadPercent : vecReadPercents) {
+                double dSingleThreadThroughput{ 0 };
+                for(std::size_t const uThreadsCount : vecThreadsCounts) {
+                    Result const stResult{ run(Run{ eScenario, bManyFiles, uThreadsCount, uReadPercent, duration }) };
+                    if(1 == uThreadsCount) {
+                        dSingleThreadThroughput = stResult.dOperationsPerSecond;
+                    }
+                    std::cout << str(eScenario) << ',' << (bManyFiles ? "many" : "one") << ',' << uThreadsCount << ',' << uReadPercent << ','
+                              << stResult.uOperations << ',' << stResult.dOperationsPerSecond << ','
+                              << (dSingleThreadThroughput > 0 ? stResult.dOperationsPerSecond / dSingleThreadThroughput : 0) << ','
+                              << stResult.p50.count() << ',' << stResult.p99.count() << ',' << stResult.p999.count() << std::endl;
+                }
+            }
+        }
+    }
+    std::cerr << "checksum " << s_llChecksum << std::endl;
+    remove_files();
+    return 0;
+}
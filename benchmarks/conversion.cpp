@@ -0,0 +1,74 @@
+/**
+ * @brief Per-value cost of the conversions between the tree strings and the setting values,
+ *        with the boost stream translator and with the charconv translator used by the library
+ */
+#include "../src/include/EmbSettings.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+
+    constexpr std::size_t s_uValuesCount{ 100000 };
+
+    template<typename Func>
+    double measure_ns_per_value(Func && a_funcBenchmark) {
+        auto const start = std::chrono::steady_clock::now();
+        a_funcBenchmark();
+        auto const stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / s_uValuesCount;
+    }
+
+    template<typename T>
+    void benchmark(std::string const& a_strTypeName, std::vector<T> const& a_vecValues) {
+        using boost::property_tree::ptree;
+        std::vector<ptree> vecStreamTrees(a_vecValues.size());
+        std::vector<ptree> vecCharconvTrees(a_vecValues.size());
+        double dChecksum{0};
+
+        auto const dStreamWrite = measure_ns_per_value([&] {
+            for(std::size_t i = 0; i < a_vecValues.size(); ++i) {
+                vecStreamTrees[i].put_value(a_vecValues[i]);
+            }
+        });
+        auto const dCharconvWrite = measure_ns_per_value([&] {
+            for(std::size_t i = 0; i < a_vecValues.size(); ++i) {
+                emb::settings::internal::write_tree(vecCharconvTrees[i], a_vecValues[i]);
+            }
+        });
+        auto const dStreamRead = measure_ns_per_value([&] {
+            for(auto const& tree : vecStreamTrees) {
+                dChecksum += tree.get_value<T>(T{});
+            }
+        });
+        auto const dCharconvRead = measure_ns_per_value([&] {
+            for(auto const& tree : vecCharconvTrees) {
+                dChecksum += emb::settings::internal::read_tree(tree, T{});
+            }
+        });
+
+        std::cout << a_strTypeName << "\twrite: " << dStreamWrite << " ns -> " << dCharconvWrite << " ns"
+                  << "\tread: " << dStreamRead << " ns -> " << dCharconvRead << " ns"
+                  << "\t(checksum " << dChecksum << ")" << std::endl;
+    }
+
+}
+
+int main() {
+    std::mt19937_64 generator{ 42 };
+    std::vector<int> veciValues(s_uValuesCount);
+    std::uniform_int_distribution<int> intDistribution{ -1000000, 1000000 };
+    for(auto & iValue : veciValues) {
+        iValue = intDistribution(generator);
+    }
+    std::vector<double> vecdValues(s_uValuesCount);
+    std::uniform_real_distribution<double> realDistribution{ -1e6, 1e6 };
+    for(auto & dValue : vecdValues) {
+        dValue = realDistribution(generator);
+    }
+
+    std::cout << s_uValuesCount << " values, per-value cost: stream translator -> charconv translator" << std::endl;
+    benchmark("int", veciValues);
+    benchmark("double", vecdValues);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @brief Memory and time costs of a large settings document,
+ *        held in a boost::property_tree::ptree and in the compact document model
+ */
+#include "../src/include/EmbSettings.hpp"
+#include "../src/src/EmbSettings_compact.hpp"
+#define BOOST_BIND_GLOBAL_PLACEHOLDERS // Avoid warning
+#include <boost/property_tree/json_parser.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+namespace {
+
+    constexpr std::size_t s_uSectionsCount{ 1000 };
+    constexpr std::size_t s_uKeysCount{ 100 };
+
+    std::size_t s_uAllocatedBytes{ 0 };
+    std::size_t s_uAllocationsCount{ 0 };
+
+    template<typename Func>
+    double measure_ms(Func && a_funcBenchmark) {
+        auto const start = std::chrono::steady_clock::now();
+        a_funcBenchmark();
+        auto const stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    /**
+     * @brief Bytes and allocations requested while running a function
+     */
+    template<typename Func>
+    std::pair<std::size_t, std::size_t> measure_allocations(Func && a_funcBenchmark) {
+        std::size_t const uBytes{ s_uAllocatedBytes };
+        std::size_t const uCount{ s_uAllocationsCount };
+        a_funcBenchmark();
+        return { s_uAllocatedBytes - uBytes, s_uAllocationsCount - uCount };
+    }
+
+}
+
+namespace {
+
+    /**
+     * @brief Counting allocation shared by all the forms of operator new
+     * @details Not inlined: the compiler sees the operators new and delete as a pair, not a malloc freed by delete
+     */
+    [[gnu::noinline]] void* allocate(std::size_t a_uSize) {
+        s_uAllocatedBytes += a_uSize;
+        ++s_uAllocationsCount;
+        if (void* p = std::malloc(a_uSize)) {
+            return p;
+        }
+        throw std::bad_alloc{};
+    }
+
+    /**
+     * @brief Deallocation shared by all the forms of operator delete
+     */
+    [[gnu::noinline]] void deallocate(void* a_p) noexcept {
+        std::free(a_p);
+    }
+
+}
+
+void* operator new(std::size_t a_uSize) {
+    return allocate(a_uSize);
+}
+
+void* operator new[](std::size_t a_uSize) {
+    return allocate(a_uSize);
+}
+
+void operator delete(void* a_p) noexcept {
+    deallocate(a_p);
+}
+
+void operator delete[](void* a_p) noexcept {
+    deallocate(a_p);
+}
+
+void operator delete(void* a_p, std::size_t) noexcept {
+    deallocate(a_p);
+}
+
+void operator delete[](void* a_p, std::size_t) noexcept {
+    deallocate(a_p);
+}
+
+int main() {
+    using boost::property_tree::ptree;
+    using emb::settings::internal::CompactTree;
+
+    // A document of 100k values, as written by a JSON settings file
+    std::stringstream streamContent{};
+    {
+        ptree source{};
+        for (std::size_t uSection = 0; uSection < s_uSectionsCount; ++uSection) {
+            ptree& section = source.add_child("section" + std::to_string(uSection), ptree{});
+            for (std::size_t uKey = 0; uKey < s_uKeysCount; ++uKey) {
+                section.add("key" + std::to_string(uKey), uSection * s_uKeysCount + uKey);
+            }
+        }
+        boost::property_tree::write_json(streamContent, source);
+    }
+    std::string const strContent{ streamContent.str() };
+
+    ptree tree{};
+    double const dParse = measure_ms([&] {
+        std::istringstream streamInput{ strContent };
+        boost::property_tree::read_json(streamInput, tree);
+    });
+
+    ptree treeCopy{};
+    auto const ptreeMemory = measure_allocations([&] { treeCopy = tree; });
+    double const dPtreeCopy = measure_ms([&] { treeCopy = tree; });
+
+    CompactTree compact{};
+    CompactTree compactCopy{};
+    auto const compactMemory = measure_allocations([&] { compact.assign(tree); });
+    double const dCompactBuild = measure_ms([&] { compact.assign(tree); });
+    double const dCompactCopy = measure_ms([&] { compactCopy = compact; });
+    double const dCompactToPtree = measure_ms([&] { compact.to_ptree(treeCopy); });
+
+    std::size_t uFound{ 0 };
+    double const dPtreeLookup = measure_ms([&] {
+        for (std::size_t uSection = 0; uSection < s_uSectionsCount; ++uSection) {
+            uFound += tree.get_child_optional("section" + std::to_string(uSection) + ".key42") ? 1 : 0;
+        }
+    });
+    double const dCompactLookup = measure_ms([&] {
+        for (std::size_t uSection = 0; uSection < s_uSectionsCount; ++uSection) {
+            uFound += CompactTree::npos != compact.find("section" + std::to_string(uSection) + ".key42") ? 1 : 0;
+        }
+    });
+
+    std::cout << compact.size() << " nodes, JSON parsing into a ptree: " << dParse << " ms (found " << uFound << ")" << std::endl;
+    std::cout << "ptree\t\t" << ptreeMemory.first / 1024 << " KiB in " << ptreeMemory.second << " allocations"
+              << "\tcopy: " << dPtreeCopy << " ms\t" << s_uSectionsCount << " lookups: " << dPtreeLookup << " ms" << std::endl;
+    std::cout << "CompactTree\t" << compactMemory.first / 1024 << " KiB in " << compactMemory.second << " allocations"
+              << " (" << compact.memory_usage() / 1024 << " KiB kept)"
+              << "\tcopy: " << dCompactCopy << " ms\t" << s_uSectionsCount << " lookups: " << dCompactLookup << " ms" << std::endl;
+    std::cout << "CompactTree built from the ptree in " << dCompactBuild << " ms, converted back in " << dCompactToPtree << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @brief Latency and throughput of the setting element operations, for each file type, value type and file size
+ * @details The results are written as CSV on the standard output, one line per measurement, to be compared between commits:
+ *          file_type,elements,element,value_type,operation,iterations,ns_per_op,ops_per_s
+ *          The size of a file is its number of elements: the benchmarked elements and scalar values filling the rest of the file.
+ *          Usage: benchmark_elements [max_elements (default 100000)]
+ */
+#include "../src/include/EmbSettings.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+enum class Mode { Off, On = 42 };
+
+// INI files only have sections and keys: the vectors are packed in a single key, and the maps are not supported
+#define BENCHMARK_ELEMENTS(_file, _type, _path, _storage)                                                                       \
+    EMBSETTINGS_FILE(_file, _type, _path)                                                                                       \
+    EMBSETTINGS_SCALAR(_file##Int, int, _file, "scalars.int", 0)                                                                \
+    EMBSETTINGS_SCALAR(_file##Double, double, _file, "scalars.double", 0.)                                                      \
+    EMBSETTINGS_SCALAR(_file##String, std::string, _file, "scalars.string", "default")                                          \
+    EMBSETTINGS_SCALAR(_file##Enum, Mode, _file, "scalars.enum", Mode::Off)                                                     \
+    EMBSETTINGS_VECTOR(_file##Vector, int, _file, "vectors.int", nullptr, _storage)                                             \
+    EMBSETTINGS_MAP(_file##Map, int, _file, "map", nullptr)
+
+BENCHMARK_ELEMENTS(XmlFile, XML, "benchmark_elements.xml", Nodes)
+BENCHMARK_ELEMENTS(JsonFile, JSON, "benchmark_elements.json", Nodes)
+BENCHMARK_ELEMENTS(IniFile, INI, "benchmark_elements.ini", Packed)
+
+namespace {
+
+    constexpr std::size_t s_uBenchmarkedElementsCount{ 6 };
+    constexpr std::chrono::milliseconds s_MinDuration{ 20 };
+    constexpr std::size_t s_uMinIterations{ 3 };
+    constexpr std::size_t s_uMaxIterations{ 1000000 };
+
+    std::size_t s_uChecksum{ 0 };
+
+    struct Measure {
+        std::size_t uIterations{ 0 };
+        double dNsPerOperation{ 0 };
+    };
+
+    /**
+     * @brief Run an operation until it has run long enough to be measured
+     */
+    template<typename Func>
+    Measure measure(Func && a_funcOperation) {
+        auto const start = std::chrono::steady_clock::now();
+        auto stop = start;
+        Measure stMeasure{};
+        while(stMeasure.uIterations < s_uMaxIterations && (stMeasure.uIterations < s_uMinIterations || stop - start < s_MinDuration)) {
+            a_funcOperation(stMeasure.uIterations);
+            ++stMeasure.uIterations;
+            stop = std::chrono::steady_clock::now();
+        }
+        stMeasure.dNsPerOperation = std::chrono::duration<double, std::nano>(stop - start).count() / stMeasure.uIterations;
+        return stMeasure;
+    }
+
+    struct Context {
+        char const* szFileType{ nullptr };
+        std::size_t uElementsCount{ 0 };
+    };
+
+    void report(Context const& a_stContext, char const* a_szElement, char const* a_szValueType, char const* a_szOperation, Measure const& a_stMeasure) {
+        std::cout << a_stContext.szFileType << ',' << a_stContext.uElementsCount << ',' << a_szElement << ',' << a_szValueType << ','
+                  << a_szOperation << ',' << a_stMeasure.uIterations << ',' << a_stMeasure.dNsPerOperation << ','
+                  << 1e9 / a_stMeasure.dNsPerOperation << std::endl;
+    }
+
+    template<typename T>
+    std::size_t checksum(T const& a_tValue) {
+        if constexpr(std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            return static_cast<std::size_t>(a_tValue);
+        }
+        else {
+            return a_tValue.size();
+        }
+    }
+
+    /**
+     * @brief Measure the operations of a setting element, writing alternately two values so that each write changes the file
+     */
+    template<typename Element, typename Type>
+    void benchmark_element(Context const& a_stContext, char const* a_szElement, char const* a_szValueType, Type const& a_tValue1, Type const& a_tValue2) {
+        report(a_stContext, a_szElement, a_szValueType, "write", measure([&](std::size_t a_uIteration) {
+            Element::write(0 == a_uIteration % 2 ? a_tValue1 : a_tValue2);
+        }));
+        report(a_stContext, a_szElement, a_szValueType, "read", measure([&](std::size_t) {
+            s_uChecksum += checksum(Element::read());
+        }));
+        report(a_stContext, a_szElement, a_szValueType, "is_default", measure([&](std::size_t) {
+            s_uChecksum += Element::is_default() ? 1 : 0;
+        }));
+        report(a_stContext, a_szElement, a_szValueType, "reset", measure([&](std::size_t) {
+            Element::reset();
+        }));
+    }
+
+    /**
+     * @brief Replace the values filling a file, so that it holds a given number of elements
+     */
+    template<typename File>
+    void fill_file(std::size_t a_uElementsCount) {
+        auto pTree = emb::settings::internal::get_file_tree(File::Name, false);
+        pTree->erase("filler");
+        auto & rFiller = pTree->add_child("filler", boost::property_tree::ptree{});
+        for(std::size_t uElement = s_uBenchmarkedElementsCount; uElement < a_uElementsCount; ++uElement) {
+            rFiller.push_back(boost::property_tree::ptree::value_type{ "key" + std::to_string(uElement), boost::property_tree::ptree{ std::to_string(uElement) } });
+        }
+    }
+
+    template<typename File, typename Int, typename Double, typename String, typename Enum, typename Vector, typename Map>
+    void benchmark_file(char const* a_szFileType, std::size_t a_uElementsCount) {
+        Context const stContext{ a_szFileType, a_uElementsCount };
+        fill_file<File>(a_uElementsCount);
+
+        benchmark_element<Int>(stContext, "scalar", "int", 42, 43);
+        benchmark_element<Double>(stContext, "scalar", "double", 0.25, 0.5);
+        benchmark_element<String>(stContext, "scalar", "string", std::string{ "first value" }, std::string{ "second value" });
+        benchmark_element<Enum>(stContext, "scalar", "enum", Mode::On, Mode::Off);
+        benchmark_element<Vector>(stContext, "vector", "int", std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8 }, std::vector<int>{ 8, 7, 6, 5, 4, 3, 2, 1 });
+        if(emb::settings::FileType::INI != File::Type) {
+            benchmark_element<Map>(stContext, "map", "int", std::map<std::string, int>{ { "a", 1 }, { "b", 2 }, { "c", 3 } },
+                                                            std::map<std::string, int>{ { "a", 3 }, { "b", 2 }, { "c", 1 } });
+        }
+
+        // The linked variables are refreshed together by the file
+        report(stContext, "linked", "all", "read_linked", measure([&](std::size_t) { File::read_linked(); }));
+        report(stContext, "linked", "all", "write_linked", measure([&](std::size_t) { File::write_linked(); }));
+    }
+
+    /**
+     * @brief Variables linked to the benchmarked elements of a file, for the whole run
+     */
+    template<typename Int, typename Double, typename String, typename Enum, typename Vector, typename Map>
+    struct LinkedVariables {
+        LinkedVariables() {
+            Int::link(iValue);
+            Double::link(dValue);
+            String::link(strValue);
+            Enum::link(eValue);
+            Vector::link(veciValues);
+            if(emb::settings::FileType::INI != Map::File::Type) {
+                Map::link(mapiValues);
+            }
+        }
+        int iValue{};
+        double dValue{};
+        std::string strValue{};
+        Mode eValue{};
+        std::vector<int> veciValues{};
+        std::map<std::string, int> mapiValues{};
+    };
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t const uMaxElementsCount{ argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000 };
+    for(char const* szPath : { "benchmark_elements.xml", "benchmark_elements.json", "benchmark_elements.ini" }) {
+        std::remove(szPath);
+    }
+    LinkedVariables<XmlFileInt, XmlFileDouble, XmlFileString, XmlFileEnum, XmlFileVector, XmlFileMap> xmlVariables{};
+    LinkedVariables<JsonFileInt, JsonFileDouble, JsonFileString, JsonFileEnum, JsonFileVector, JsonFileMap> jsonVariables{};
+    LinkedVariables<IniFileInt, IniFileDouble, IniFileString, IniFileEnum, IniFileVector, IniFileMap> iniVariables{};
+
+    std::cout << "file_type,elements,element,value_type,operation,iterations,ns_per_op,ops_per_s" << std::endl;
+    for(std::size_t uElementsCount = 10; uElementsCount <= uMaxElementsCount; uElementsCount *= 10) {
+        benchmark_file<XmlFile, XmlFileInt, XmlFileDouble, XmlFileString, XmlFileEnum, XmlFileVector, XmlFileMap>("XML", uElementsCount);
+        benchmark_file<JsonFile, JsonFileInt, JsonFileDouble, JsonFileString, JsonFileEnum, JsonFileVector, JsonFileMap>("JSON", uElementsCount);
+        benchmark_file<IniFile, IniFileInt, IniFileDouble, IniFileString, IniFileEnum, IniFileVector, IniFileMap>("INI", uElementsCount);
+    }
+    std::cerr << "checksum " << s_uChecksum << std::endl;
+    for(char const* szPath : { "benchmark_elements.xml", "benchmark_elements.json", "benchmark_elements.ini" }) {
+        std::remove(szPath);
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Startup and registration cost of the settings schemas, by number of setting elements and of settings files.
+
+For each schema size, a program declaring the elements with the EmbSettings macros is generated with its JSON
+settings files, compiled and run. The results are written as CSV on the standard output, one line per schema,
+to be compared between commits:
+    elements,files,compile_s,binary_bytes,static_init_us,first_access_us
+- compile_s:        time to compile and link the generated program
+- binary_bytes:     size of the generated program
+- static_init_us:   time spent in the static initialization, which registers the files and the elements (median of the runs)
+- first_access_us:  time to load and parse all the files, by a first access to one element of each file (median of the runs)
+
+Usage: schema.py --library <libEmbSettings.a> [--include <src/include>] [--elements 10,100,...] [--files 1,10,...]
+"""
+import argparse
+import json
+import os
+import shlex
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+ELEMENT_TYPES = (
+    ("EMBSETTINGS_SCALAR({name}, int, {file}, \"{key}\", 0)", lambda i: str(i)),
+    ("EMBSETTINGS_SCALAR({name}, double, {file}, \"{key}\", 0.5)", lambda i: str(i + 0.25)),
+    ("EMBSETTINGS_SCALAR({name}, std::string, {file}, \"{key}\", \"default\")", lambda i: "value" + str(i)),
+    ("EMBSETTINGS_VECTOR({name}, int, {file}, \"{key}\", nullptr)", lambda i: [str(i), str(i + 1), str(i + 2)]),
+)
+
+
+def element_key(element, files_count):
+    """Key of an element: the elements of a file are grouped in sections of 100 keys"""
+    return "section{}.key{}".format(element // files_count // 100, element)
+
+
+def generate(directory, elements_count, files_count):
+    """Write the program declaring the schema and the settings files holding a value for each element"""
+    contents = [dict() for _ in range(files_count)]
+    lines = [
+        "// Generated by schema.py: {} setting elements in {} settings files".format(elements_count, files_count),
+        "#include \"EmbSettings.hpp\"",
+        "#include <chrono>",
+        "#include <cstdio>",
+        "",
+        "namespace {",
+        "    struct StartTime {",
+        "        std::chrono::steady_clock::time_point time{ std::chrono::steady_clock::now() };",
+        "    };",
+        "    // Initialized before the registrations of the files and of the elements",
+        "#if defined(__GNUC__)",
+        "    StartTime const s_start __attribute__((init_priority(101)));",
+        "#else",
+        "    StartTime const s_start;",
+        "#endif",
+        "}",
+        "",
+    ]
+    for file in range(files_count):
+        lines.append("EMBSETTINGS_FILE(F{0}, JSON, \"schema_{0}.json\")".format(file))
+    for element in range(elements_count):
+        file = element % files_count
+        declaration, value = ELEMENT_TYPES[element % len(ELEMENT_TYPES)]
+        key = element_key(element, files_count)
+        lines.append(declaration.format(name="E{}".format(element), file="F{}".format(file), key=key))
+        section, name = key.split(".")
+        contents[file].setdefault(section, {})[name] = value(element)
+    lines += [
+        "",
+        "int main() {",
+        "    auto const staticInit = std::chrono::steady_clock::now() - s_start.time;",
+        "    auto const start = std::chrono::steady_clock::now();",
+        "    unsigned uDefaults{ 0 };",
+    ]
+    # The first element of each file is declared in it: its first access loads the file
+    for file in range(min(files_count, elements_count)):
+        lines.append("    uDefaults += E{}::is_default() ? 1 : 0;".format(file))
+    lines += [
+        "    auto const firstAccess = std::chrono::steady_clock::now() - start;",
+        "    std::printf(\"%lld %lld %u\\n\", static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(staticInit).count()),",
+        "                static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(firstAccess).count()), uDefaults);",
+        "    return 0;",
+        "}",
+        "",
+    ]
+    with open(os.path.join(directory, "schema.cpp"), "w") as source:
+        source.write("\n".join(lines))
+    for file in range(files_count):
+        with open(os.path.join(directory, "schema_{}.json".format(file)), "w") as content:
+            json.dump(contents[file], content, indent=4)
+
+
+def benchmark(arguments, elements_count, files_count):
+    with tempfile.TemporaryDirectory(prefix="embsettings_schema_") as directory:
+        generate(directory, elements_count, files_count)
+        program = os.path.join(directory, "schema")
+        command = [arguments.compiler, "-std=c++17"] + shlex.split(arguments.cxxflags) + [
+            "-I", arguments.include, os.path.join(directory, "schema.cpp"), "-o", program,
+            arguments.library, "-pthread"] + shlex.split(arguments.ldflags)
+        start = time.perf_counter()
+        subprocess.run(command, check=True)
+        compile_duration = time.perf_counter() - start
+        static_init = []
+        first_access = []
+        for _ in range(arguments.runs):
+            output = subprocess.run([program], cwd=directory, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout.split()
+            static_init.append(int(output[0]))
+            first_access.append(int(output[1]))
+        print("{},{},{:.2f},{},{},{}".format(elements_count, files_count, compile_duration, os.path.getsize(program),
+                                           statistics.median(static_init), statistics.median(first_access)), flush=True)
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--library", required=True, help="EmbSettings static library to link")
+    parser.add_argument("--include", default=os.path.join(root, "src", "include"), help="EmbSettings include directory")
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--cxxflags", default="-O2", help="Compilation flags, e.g. the boost include directory")
+    parser.add_argument("--ldflags", default="-lstdc++fs" if sys.platform.startswith("linux") else "")
+    parser.add_argument("--elements", default="10,100,1000,10000,50000", help="Numbers of setting elements")
+    parser.add_argument("--files", default="1,10,100,1000", help="Numbers of settings files")
+    parser.add_argument("--runs", type=int, default=5, help="Runs of each generated program")
+    arguments = parser.parse_args()
+
+    print("elements,files,compile_s,binary_bytes,static_init_us,first_access_us", flush=True)
+    for elements_count in (int(count) for count in arguments.elements.split(",")):
+        for files_count in (int(count) for count in arguments.files.split(",")):
+            if files_count <= elements_count:
+                benchmark(arguments, elements_count, files_count)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,6 +5,17 @@
 #include <map>
 #include <vector>
 #include <functional>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <optional>
+#include <string_view>
+#include <iterator>
+#include <unordered_map>
+#include <array>
+#include <mutex>
+#include <cassert>
 #ifdef _
 #pragma push_macro("_")
 #undef _
@@ -34,13 +45,28 @@
  */
 #define EMBSETTINGS_SCALAR(...) EMBSETTINGS_INTERNAL_VFUNC(EMBSETTINGS_INTERNAL_SCALAR_, __VA_ARGS__)
 
+/**
+ * @brief Declare a scalar setting read from hot paths inside a previously declared setting file
+ * @details The decoded value is mirrored in a cache-line-aligned lock-free variable refreshed on write, reset and reload:
+ *          read() is a single wait-free load, without lock, allocation nor tree access, usable from real-time threads.
+ *          The first read() registers the mirror and must not happen in a real-time thread.
+ *          Reads are not reported to the monitoring callback.
+ * @param 1 [mandatory] Name of the class representing the setting
+ * @param 2 [mandatory] Data type of the setting, must be trivially copyable (bool, integers, floating points, enums, POD structs)
+ * @param 3 [mandatory] Class name of the file used to save the setting
+ * @param 4 [mandatory] Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param 5 [optional]  Default value of the setting if not found in the file (if not provided default value is {})
+ */
+#define EMBSETTINGS_HOT_SCALAR(...) EMBSETTINGS_INTERNAL_VFUNC(EMBSETTINGS_INTERNAL_HOT_SCALAR_, __VA_ARGS__)
+
 /**
  * @brief Declare a vector setting inside a previously declared setting file
  * @param 1 [mandatory] Name of the class representing the setting
  * @param 2 [mandatory] Base data type of the setting. The final setting's data type is std::vector<_type>
  * @param 3 [mandatory] Class name of the file used to save the setting
  * @param 4 [mandatory] Key string representing the position of the setting in the file (using boost property_tree synthax)
- * @param 5 [optional]  Pointer to a default value of the setting if not found in the file (if not provided default value is {})
+ * @param 5 [optional]  Pointer to a default value of the setting if not found in the file (can be nullptr, if not provided default value is {})
+ * @param 6 [optional]  Storage of the values in the file (amongst \c emb::settings::VectorStorage enumeration, without the scope: e.g. Packed)
  */
 #define EMBSETTINGS_VECTOR(...) EMBSETTINGS_INTERNAL_VFUNC(EMBSETTINGS_INTERNAL_VECTOR_, __VA_ARGS__)
 
@@ -54,6 +80,41 @@
  */
 #define EMBSETTINGS_MAP(...) EMBSETTINGS_INTERNAL_VFUNC(EMBSETTINGS_INTERNAL_MAP_, __VA_ARGS__)
 
+/**
+ * @brief Declare the fields of an aggregate that can be stored by EMBSETTINGS_STRUCT, at global scope
+ * @param 1 [mandatory] Aggregate type
+ * @param ... [mandatory] Names of its fields (up to 16), each one stored in a child node of the same name.
+ *            The fields can be of any scalar type, or of another aggregate declared with EMBSETTINGS_STRUCT_FIELDS
+ */
+#define EMBSETTINGS_STRUCT_FIELDS(...) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_STRUCT_FIELDS(__VA_ARGS__))
+
+/**
+ * @brief Declare a struct setting inside a previously declared setting file
+ * @details All the fields are read in one locked pass on the subtree of the setting, and written with one serialization.
+ *          A field absent from the file has the value it has in the default value.
+ *          The element behaves like a scalar setting (default value, reset, is_default, link, subscribe).
+ * @param 1 [mandatory] Name of the class representing the setting
+ * @param 2 [mandatory] Aggregate type of the setting, whose fields are declared with EMBSETTINGS_STRUCT_FIELDS
+ * @param 3 [mandatory] Class name of the file used to save the setting
+ * @param 4 [mandatory] Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param 5 [optional]  Default value of the setting if not found in the file, between parentheses if it contains commas
+ *                      (if not provided default value is {})
+ */
+#define EMBSETTINGS_STRUCT(...) EMBSETTINGS_INTERNAL_VFUNC(EMBSETTINGS_INTERNAL_STRUCT_, __VA_ARGS__)
+
+/**
+ * @brief Declare a table setting inside a previously declared setting file
+ * @details The rows are kept in memory by columns (see \c emb::settings::Table) and stored in the file with one node per row,
+ *          whose fields are separated by ';' (in the order of EMBSETTINGS_STRUCT_FIELDS, ';' and '\\' being escaped by '\\').
+ *          The default value is an empty table.
+ * @param 1 [mandatory] Name of the class representing the setting
+ * @param 2 [mandatory] Aggregate type of the rows, whose scalar fields are declared with EMBSETTINGS_STRUCT_FIELDS
+ * @param 3 [mandatory] Class name of the file used to save the setting
+ * @param 4 [mandatory] Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param 5 [mandatory] Field of the rows used as primary key
+ */
+#define EMBSETTINGS_TABLE(...) EMBSETTINGS_INTERNAL_VFUNC(EMBSETTINGS_INTERNAL_TABLE_, __VA_ARGS__)
+
 namespace emb {
     namespace settings {
         /**
@@ -123,8 +184,8 @@ namespace emb {
          */
         struct MonitoringInformation {
             MonitoringOperation eOperation{};
-            std::string strFileName{};
-            std::string strElementName{};
+            std::string_view strFileName{};     ///< Interned name, valid for the program lifetime
+            std::string_view strElementName{};  ///< Interned name, valid for the program lifetime
             std::string strValue{};
         };
         /**
@@ -137,6 +198,223 @@ namespace emb {
          */
         void set_monitoring_callback(MonitoringCallback const& a_fctMonitoringCallback = {});
 
+        /**
+         * @brief Starts a background thread that reloads the settings files modified by other processes (Linux only, uses inotify)
+         * @details Modifications, renames and replacements of the loaded settings files are detected. Once no more event
+         *          is received for \c a_Debounce, only the changed file is parsed again and its tree is swapped under the file lock.
+         *          Writes made by the library itself are not reloaded. Files with a pending transaction are not reloaded.
+         * @param a_Debounce    Quiet period to wait after the last event before reloading a file
+         * @return true         The watcher is running
+         * @return false        The watcher cannot be started (unsupported platform or inotify error)
+         */
+        bool start_file_watcher(std::chrono::milliseconds a_Debounce = std::chrono::milliseconds{100});
+
+        /**
+         * @brief Defines the memory budget of the loaded settings files
+         * @details When the loaded files use more than the budget, the least recently used ones are unloaded until the budget
+         *          is met again. They are read again on next access. Only the files that are not locked, without pending
+         *          modification or transaction, and without subscriber nor variable linked in LinkMode::AutoRefresh are unloaded.
+         *          A budget smaller than the files used together makes them read again on each access.
+         * @param a_uBytes      Budget in bytes, 0 for no budget (default)
+         */
+        void set_memory_budget(std::size_t a_uBytes = 0);
+
+        /**
+         * @brief Get the memory used by a settings file: its tree, its backup tree during a transaction and its serialized content
+         * @param a_strFileName Name of the settings file
+         * @return std::size_t  Estimated number of bytes, 0 if the file is unknown or not loaded
+         */
+        std::size_t get_file_memory_usage(std::string const& a_strFileName);
+
+        /**
+         * @brief Memory used by a settings file, estimated in bytes
+         */
+        struct FileMemoryStats {
+            std::string strFileName{};
+            bool bLoaded{false};                ///< The tree is in memory (read and not unloaded to meet the memory budget)
+            std::size_t uNodesCount{0};         ///< Nodes of the tree
+            std::size_t uKeysBytes{0};          ///< Characters of the keys of the tree
+            std::size_t uValuesBytes{0};        ///< Characters of the values of the tree
+            std::size_t uTreeBytes{0};          ///< Tree, including its nodes, keys and values
+            std::size_t uBackupTreeBytes{0};    ///< Tree seen by the readers during a transaction
+            std::size_t uCompactTreeBytes{0};   ///< Compact copy of the tree of a file unloaded to meet the memory budget
+            std::size_t uContentBytes{0};       ///< Serialized content retained to detect the unchanged writes
+            std::size_t uSidecarsBytes{0};      ///< Mapped sidecar files and sidecar files written by a pending transaction
+            std::size_t uCachesBytes{0};        ///< Key index of the change notifications
+            std::size_t uTotalBytes{0};
+        };
+        /**
+         * @brief Memory used by the settings subsystem, estimated in bytes
+         */
+        struct MemoryStats {
+            std::vector<FileMemoryStats> vecFiles{};
+            std::size_t uRegistryBytes{0};      ///< Registered files and elements, subscribers, jokers and interned names
+            std::size_t uTotalBytes{0};         ///< Files and registry
+        };
+        /**
+         * @brief Get the memory used by each registered settings file and by the registry
+         * @details The modifications only mark the files as changed: the trees of the files changed since the previous
+         *          sample are measured by this function, get_file_memory_usage and the memory budget, the others are not walked.
+         * @return MemoryStats  Memory used, by file in name order
+         */
+        MemoryStats memory_stats();
+
+        /**
+         * @brief Distribution of durations in fixed buckets
+         */
+        struct LatencyHistogram {
+            static constexpr std::size_t BucketsCount{ 16 };
+            /**
+             * @brief Upper bound of a bucket: bucket i counts the durations below 2^i microseconds not counted by the previous
+             *        buckets, the last bucket counts all the longer durations
+             */
+            static std::chrono::microseconds bucket_upper_bound(std::size_t a_uBucket);
+            std::array<std::uint64_t, BucketsCount> auCounts{};
+            std::uint64_t uCount{0};                ///< Number of durations
+            std::chrono::nanoseconds total{};       ///< Sum of the durations
+        };
+        /**
+         * @brief Performance counters of a settings file, since the start of the program
+         */
+        struct FileStats {
+            std::string strFileName{};
+            std::uint64_t uReads{0};                ///< Trees locked for reading (element reads, is_default, views...)
+            std::uint64_t uWrites{0};               ///< Trees locked for writing (element writes and resets, restores...)
+            std::uint64_t uResets{0};               ///< Setting elements reset
+            std::uint64_t uLocks{0};                ///< Trees locked
+            std::chrono::nanoseconds lockWait{};    ///< Time spent waiting for the file lock held by other threads
+            std::chrono::nanoseconds serialize{};   ///< Time spent serializing the tree before writing the file
+            std::uint64_t uBytesWritten{0};         ///< Bytes written to the file
+            std::uint64_t uSkippedWrites{0};        ///< File writes skipped because the serialized content was unchanged
+            std::chrono::nanoseconds parse{};       ///< Time spent parsing the file
+            std::uint64_t uReloads{0};              ///< File read again after its first load (external modification, restore, memory budget)
+            LatencyHistogram lockWaitHistogram{};
+            LatencyHistogram serializeHistogram{};
+            LatencyHistogram diskWriteHistogram{};
+        };
+        /**
+         * @brief Get the performance counters of each registered settings file
+         * @details The counters are kept in per-thread shards updated without lock, and merged here
+         * @return std::vector<FileStats>   Counters, by file in name order
+         */
+        std::vector<FileStats> stats();
+
+        /**
+         * @brief Starts recording which setting elements or operations hold the settings files locks, and which ones wait for them
+         * @details The records of a previous profiling are cleared. When the profiler is stopped, locking a file costs a single branch.
+         */
+        void start_contention_profiler();
+        /**
+         * @brief Stops the profiler started by \c start_contention_profiler, its records are kept for \c contention_report
+         */
+        void stop_contention_profiler();
+        /**
+         * @brief Lock of a settings file held by a setting element or an operation
+         */
+        struct LockHold {
+            std::string strFileName{};
+            std::string strHolder{};                ///< Setting element or operation holding the lock
+            std::uint64_t uCount{0};
+            std::chrono::nanoseconds total{};
+            std::chrono::nanoseconds max{};
+        };
+        /**
+         * @brief Setting element or operation that waited for the lock of a settings file held by another one
+         */
+        struct LockWait {
+            std::string strFileName{};
+            std::string strHolder{};                ///< Setting element or operation holding the lock when the wait began
+            std::string strWaiter{};                ///< Setting element or operation waiting for the lock
+            std::uint64_t uCount{0};
+            std::chrono::nanoseconds total{};
+            std::chrono::nanoseconds max{};
+        };
+        struct ContentionReport {
+            std::vector<LockWait> vecBlockingPairs{};   ///< Longest total waits first
+            std::vector<LockHold> vecHolders{};         ///< Longest total holds first
+        };
+        /**
+         * @brief Get the records of the contention profiler
+         * @param a_uTopN               Maximum number of blocking pairs and of holders
+         * @return ContentionReport     Blocking pairs and holders of all the files
+         */
+        ContentionReport contention_report(std::size_t a_uTopN = 10);
+        /**
+         * @brief Dump a contention report as JSON
+         * @param a_stReport            Report to dump
+         * @return std::string          {"blocking_pairs":[{"file","holder","waiter","count","total_ns","max_ns"}...],"holders":[{"file","holder","count","total_ns","max_ns"}...]}
+         */
+        std::string to_json(ContentionReport const& a_stReport);
+
+        /**
+         * @brief Step of the life of a settings file traced in a span
+         */
+        enum class TraceSpanType {
+            Load,       ///< File read from disk, parsed and migrated
+            Parse,      ///< Content parsed into the tree
+            Serialize,  ///< Tree serialized before writing the file
+            Compare,    ///< Serialized content compared to the file content, to skip the unchanged writes
+            DiskWrite,  ///< Serialized content written to the file
+            Flush,      ///< File flushed and closed (the library does not call fsync: the content may stay in the OS cache)
+            Migration,  ///< Version callback called on a file of another version
+        };
+        char const* str(TraceSpanType a_eTraceSpanType);
+        /**
+         * @brief Span traced around a step of the life of a settings file
+         */
+        struct TraceSpan {
+            TraceSpanType eType{};
+            std::string_view strFileName{};                     ///< Interned name, valid for the program lifetime
+            std::size_t uBytes{0};                              ///< Bytes read, parsed, serialized, compared or written, 0 if unknown yet
+            std::chrono::steady_clock::time_point start{};
+            std::chrono::nanoseconds duration{};                ///< Set when the span ends
+        };
+        /**
+         * @brief Receiver of the spans traced by the library
+         * @details The spans of a thread are nested: each begin_span is followed by its end_span after the ones of its inner spans.
+         *          The methods are called with the file locked: they must be short and must not access the settings.
+         */
+        class Tracer {
+        public:
+            virtual ~Tracer() = default;
+            virtual void begin_span(TraceSpan const& a_stSpan) = 0;
+            virtual void end_span(TraceSpan const& a_stSpan) = 0;
+        };
+        /**
+         * @brief Defines the tracer receiving the spans. When no tracer is set, tracing a span costs a single branch.
+         * @param a_pTracer     Tracer to set, nullptr to disable
+         */
+        void set_tracer(std::shared_ptr<Tracer> const& a_pTracer = {});
+        /**
+         * @brief Tracer recording the spans as Chrome trace events, to be displayed by chrome://tracing or Perfetto
+         */
+        class ChromeTraceExporter : public Tracer {
+        public:
+            ChromeTraceExporter();
+            void begin_span(TraceSpan const& a_stSpan) override;
+            void end_span(TraceSpan const& a_stSpan) override;
+            /**
+             * @brief Dump the recorded spans as complete events, timestamped from the creation of the exporter
+             * @return std::string  {"traceEvents":[{"name","cat","ph":"X","ts","dur","pid","tid","args":{"file","bytes"}}...]}
+             */
+            std::string to_json() const;
+            void clear();
+
+        private:
+            struct Event {
+                TraceSpan stSpan{};
+                std::size_t uThreadId{0};
+            };
+            std::chrono::steady_clock::time_point const m_Origin;
+            mutable std::mutex m_mutex{};
+            std::vector<Event> m_vecEvents{};
+        };
+
+        /**
+         * @brief Stops the background thread started by \c start_file_watcher
+         */
+        void stop_file_watcher();
+
         /**
          * @brief Get the file names list object
          *
@@ -160,6 +438,334 @@ namespace emb {
          */
         using version_clbk_t = bool(*)(int a_iOldVersion, int a_iNewNersion);
 
+        /**
+         * @brief Type of the callback called when the value of a setting element is changed by a reload of its file
+         * @param a_tOld    Value before the reload
+         * @param a_tNew    Value after the reload
+         */
+        template<typename T>
+        using change_clbk_t = std::function<void(T const& a_tOld, T const& a_tNew)>;
+
+        /**
+         * @brief How a variable linked to a setting element is updated
+         */
+        enum class LinkMode {
+            OnDemand,       ///< The variable is only updated by the file's read_linked() and written by its write_linked()
+            AutoRefresh,    ///< The variable is also updated in place each time the setting element is written, reset or reloaded
+        };
+        char const* str(LinkMode a_eLinkMode);
+
+        /**
+         * @brief How the values of a vector setting element are stored in its file
+         */
+        enum class VectorStorage {
+            Nodes,      ///< One node per value
+            Packed,     ///< One node holding the values separated by spaces, parsed and formatted in bulk (arithmetic types only)
+            Sidecar,    ///< Binary file next to the settings file, referenced by the element's node and mapped in memory
+                        ///< (arithmetic types only, in the native representation of the platform)
+        };
+        char const* str(VectorStorage a_eVectorStorage);
+
+        namespace internal {
+
+            /**
+             * @brief Sequence lock protecting a trivially copyable value: the writer never blocks, readers retry if a store happened meanwhile
+             */
+            template<typename T>
+            class TSeqLock {
+            public:
+                T load() const;
+                void store(T const& a_tValue);
+
+            private:
+                static constexpr std::size_t s_uWords{ (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) };
+                std::atomic<std::uint32_t> m_uSequence{0};      ///< Odd while a store is in progress
+                std::atomic<std::uint64_t> m_auWords[s_uWords]{};
+            };
+
+            /**
+             * @brief Tell if std::atomic<T> is lock-free, without instantiating it for types that are not trivially copyable
+             */
+            template<typename T>
+            struct is_always_lock_free : std::bool_constant<std::atomic<T>::is_always_lock_free> {};
+
+            /**
+             * @brief Trivially copyable value readable without lock: a std::atomic when it is lock-free for T, a sequence lock otherwise
+             */
+            template<typename T>
+            class TLockFreeValue {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read without lock");
+            public:
+                T load() const;
+                void store(T const& a_tValue);
+
+            private:
+                static constexpr bool s_bAtomic{ std::conjunction_v<std::is_trivially_copyable<T>, is_always_lock_free<T>> };
+                std::conditional_t<s_bAtomic, std::atomic<T>, TSeqLock<T>> m_value{};
+            };
+
+            /**
+             * @brief Mirror of a hot scalar setting element, alone on its cache line
+             */
+            template<typename T>
+            struct alignas(64) THotMirror {
+                TLockFreeValue<T> value{};
+                std::atomic<bool> bPrimed{false};
+            };
+        }
+
+        /**
+         * @brief Variable linked to a setting element, refreshed by the library and readable from any thread without locking
+         * @details Trivially copyable types are stored in a std::atomic if it is lock-free, or protected by a sequence lock:
+         *          readers never block and only retry if a refresh happened while they were reading.
+         *          Other types are published as immutable snapshots.
+         * @tparam T    Type of the variable
+         */
+        template<typename T, bool = std::is_trivially_copyable_v<T>>
+        class Linked;
+
+        /**
+         * @brief Linked variable of a trivially copyable type, stored in a lock-free atomic or protected by a sequence lock
+         */
+        template<typename T>
+        class Linked<T, true> {
+        public:
+            Linked();
+            explicit Linked(T const& a_tValue);
+            Linked(Linked const&) = delete;
+            Linked& operator=(Linked const&) = delete;
+            /**
+             * @brief Get the current value. Never blocks, never allocates
+             * @return T    Current value
+             */
+            T load() const;
+            operator T() const;
+            /**
+             * @brief Set a new value. Writers must be serialized (the library refreshes it with the file locked)
+             * @param a_tValue  New value
+             */
+            void store(T const& a_tValue);
+
+        private:
+            internal::TLockFreeValue<T> m_value{};
+        };
+
+        /**
+         * @brief Linked variable of a non trivially copyable type, published as immutable snapshots
+         */
+        template<typename T>
+        class Linked<T, false> {
+        public:
+            Linked();
+            explicit Linked(T const& a_tValue);
+            Linked(Linked const&) = delete;
+            Linked& operator=(Linked const&) = delete;
+            /**
+             * @brief Get a copy of the current value
+             * @return T    Current value
+             */
+            T load() const;
+            operator T() const;
+            /**
+             * @brief Get the current value without copying it. The snapshot stays valid after a refresh
+             * @return std::shared_ptr<T const> Current value
+             */
+            std::shared_ptr<T const> snapshot() const;
+            /**
+             * @brief Set a new value
+             * @param a_tValue  New value
+             */
+            void store(T const& a_tValue);
+
+        private:
+            std::shared_ptr<T const> m_pValue{};
+        };
+
+        /**
+         * @brief Read-only view on contiguous values, keeping their storage alive (e.g. a mapped sidecar file)
+         * @tparam T    Type of the values
+         */
+        template<typename T>
+        class ArrayView {
+        public:
+            ArrayView() = default;
+            ArrayView(std::shared_ptr<void const> a_pOwner, T const* a_ptData, std::size_t a_uSize)
+                : m_pOwner{ std::move(a_pOwner) }, m_ptData{ a_ptData }, m_uSize{ a_uSize } {}
+            T const* data() const { return m_ptData; }
+            std::size_t size() const { return m_uSize; }
+            bool empty() const { return 0 == m_uSize; }
+            T const* begin() const { return m_ptData; }
+            T const* end() const { return m_ptData + m_uSize; }
+            T const& operator[](std::size_t a_uIndex) const { return m_ptData[a_uIndex]; }
+
+        private:
+            std::shared_ptr<void const> m_pOwner{};     ///< Keeps the values alive, even if the setting element is written meanwhile
+            T const* m_ptData{nullptr};
+            std::size_t m_uSize{0};
+        };
+
+        /**
+         * @brief Type of the values seen through a ReadGuard: strings are borrowed from the tree, the other types are converted
+         * @tparam T    Type of the setting element values
+         */
+        template<typename T>
+        using ViewType = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+        /**
+         * @brief Fields of an aggregate stored by struct setting elements, specialized by EMBSETTINGS_STRUCT_FIELDS
+         * @tparam T    Aggregate type
+         */
+        template<typename T>
+        struct StructFields {};
+
+        class ReadGuard;
+        template<typename T, bool _Keyed>
+        class ChildrenView;
+
+        /**
+         * @brief Rows of a table setting element, kept by columns (structure of arrays)
+         * @details Each field of the record is a contiguous std::vector: filters and aggregates on a column are plain loops
+         *          over an array, which the compiler can vectorize. Rows are found by their primary key through a hash index.
+         *          The bool fields are stored as std::uint8_t (0 or 1): std::vector<bool> packs bits, which defeats these loops.
+         * @tparam Record       Aggregate type of the rows, whose fields are declared with EMBSETTINGS_STRUCT_FIELDS
+         * @tparam _KeyField    Field of the record used as primary key (e.g. &Record::id)
+         */
+        template<typename Record, auto _KeyField>
+        class Table {
+        public:
+            using Key = std::decay_t<decltype(std::declval<Record const&>().*_KeyField)>;
+            /**
+             * @brief Type of the values stored in the column of a field
+             */
+            template<typename Field>
+            using ColumnValue = std::conditional_t<std::is_same_v<Field, bool>, std::uint8_t, Field>;
+
+            Table();
+            Table(Table const& a_Other);
+            /**
+             * @brief Move the rows of another table, which is left empty with new columns
+             */
+            Table(Table && a_Other);
+            Table& operator=(Table const& a_Other);
+            /**
+             * @brief Move the rows of another table, which is left empty with the former columns of this one
+             */
+            Table& operator=(Table && a_Other) noexcept;
+            ~Table() = default;
+
+            /**
+             * @brief Get the number of rows
+             */
+            std::size_t size() const { return m_uSize; }
+            /**
+             * @brief Indicate if the table has no row
+             */
+            bool empty() const { return 0 == m_uSize; }
+            /**
+             * @brief Reserve the columns for a number of rows
+             * @param a_uSize   Number of rows
+             */
+            void reserve(std::size_t a_uSize);
+            /**
+             * @brief Remove all the rows
+             */
+            void clear();
+            /**
+             * @brief Append a row
+             * @param a_stRow   Row to append
+             * @return true     The row has been appended
+             * @return false    A row with the same primary key exists
+             */
+            bool insert(Record const& a_stRow);
+            /**
+             * @brief Replace the row having the same primary key
+             * @param a_stRow   New content of the row
+             * @return true     The row has been replaced
+             * @return false    No row has this primary key
+             */
+            bool update(Record const& a_stRow);
+            /**
+             * @brief Remove a row, in constant time: the last row takes its position
+             * @param a_tKey    Primary key of the row
+             * @return true     The row has been removed
+             * @return false    No row has this primary key
+             */
+            bool erase(Key const& a_tKey);
+            /**
+             * @brief Find a row by its primary key, in constant time
+             * @param a_tKey    Primary key of the row
+             * @return std::optional<std::size_t> Position of the row, std::nullopt if no row has this primary key
+             */
+            std::optional<std::size_t> find(Key const& a_tKey) const;
+            /**
+             * @brief Get a row by its primary key
+             * @param a_tKey    Primary key of the row
+             * @return std::optional<Record> Row, std::nullopt if no row has this primary key
+             */
+            std::optional<Record> get(Key const& a_tKey) const;
+            /**
+             * @brief Gather a row from the columns
+             * @param a_uIndex  Position of the row, lower than size()
+             * @return Record   Row
+             */
+            Record row(std::size_t a_uIndex) const;
+            /**
+             * @brief Get the values of a field for all the rows
+             * @param a_pField  Field of the record (e.g. &Record::gain)
+             * @return std::vector<ColumnValue<Field>> const& Column of the field, one value per row
+             */
+            template<typename Field>
+            std::vector<ColumnValue<Field>> const& column(Field Record::* a_pField) const;
+            /**
+             * @brief Get the positions of the rows whose field matches a predicate
+             * @details The predicate is evaluated in a branchless loop over the column, then the positions are gathered
+             * @param a_pField      Field of the record
+             * @param a_funcPred    Predicate: bool(Field const&)
+             * @return std::vector<std::size_t> Positions of the matching rows, in order
+             */
+            template<typename Field, typename Pred>
+            std::vector<std::size_t> filter(Field Record::* a_pField, Pred a_funcPred) const;
+            /**
+             * @brief Count the rows whose field matches a predicate
+             * @param a_pField      Field of the record
+             * @param a_funcPred    Predicate: bool(Field const&)
+             * @return std::size_t  Number of matching rows
+             */
+            template<typename Field, typename Pred>
+            std::size_t count_if(Field Record::* a_pField, Pred a_funcPred) const;
+            /**
+             * @brief Sum the values of an arithmetic field
+             * @param a_pField  Field of the record
+             * @return Field    Sum of the column
+             */
+            template<typename Field>
+            Field sum(Field Record::* a_pField) const;
+
+            bool operator==(Table const& a_Other) const;
+            bool operator!=(Table const& a_Other) const { return !(*this == a_Other); }
+
+        private:
+            struct ColumnBase {
+                virtual ~ColumnBase() = default;
+                virtual std::unique_ptr<ColumnBase> clone() const = 0;
+                virtual void reserve(std::size_t a_uSize) = 0;
+                virtual void clear() = 0;
+                virtual void swap_remove(std::size_t a_uIndex) = 0;
+                virtual bool equals(ColumnBase const& a_Other) const = 0;
+            };
+            template<typename Field>
+            struct TColumn;
+
+            template<typename Field>
+            std::size_t column_index(Field Record::* a_pField) const;
+            template<typename Func>
+            void for_each_column(Func && a_funcVisit) const;
+
+            std::vector<std::unique_ptr<ColumnBase>> m_vecColumns{};    ///< One column per field, in the order of EMBSETTINGS_STRUCT_FIELDS
+            std::unordered_map<Key, std::size_t> m_mapIndex{};         ///< Primary key -> position of the row
+            std::size_t m_uSize{0};
+        };
+
         /**
          * @brief The internal namespace contains elements that are not part of the public API and are not meant to be called directly
          */
@@ -179,24 +785,24 @@ namespace emb {
             public:
                 /**
                  * @brief Get the setting element's name
-                 * @return std::string  Name of the setting element
+                 * @return std::string_view  Name of the setting element, interned
                  */
-                std::string get_name_m() const;
+                std::string_view get_name_m() const;
                 /**
                  * @brief Get the setting element's type
-                 * @return std::string  Type of the setting element
+                 * @return std::string_view  Type of the setting element, interned
                  */
-                std::string get_type_m() const;
+                std::string_view get_type_m() const;
                 /**
                  * @brief Get the setting element's file name
-                 * @return std::string  File name of the setting element
+                 * @return std::string_view  File name of the setting element, interned
                  */
-                std::string get_file_m() const;
+                std::string_view get_file_m() const;
                 /**
                  * @brief Get the setting element's Key
-                 * @return std::string  Key of the setting element
+                 * @return std::string_view  Key of the setting element, interned
                  */
-                std::string get_key_m() const;
+                std::string_view get_key_m() const;
                 /**
                  * @brief Read the linked variables
                  */
@@ -239,7 +845,7 @@ namespace emb {
                  * @param a_strFile     Name of the file where the setting element is stored
                  * @param a_strKey      Key of the setting element in the file
                  */
-                SettingElement(std::string const& a_strName, std::string const& a_strType, std::string const& a_strFile, std::string const& a_strKey);
+                SettingElement(std::string_view a_strName, std::string_view a_strType, std::string_view a_strFile, std::string_view a_strKey);
                 /**
                  * @brief Destroy the Setting Element object
                  */
@@ -259,11 +865,11 @@ namespace emb {
                  * @tparam Type         Type of the setting
                  * @param a_strFile     Name of the file where the setting element is stored
                  * @param a_strElement  Name of the setting element in the file
-                 * @param a_tNew        Value to write
+                 * @param a_tNew        Value to write, moved into the tree if it is an rvalue
                  * @param a_bMonitor    True to monitor write operation
                  */
-                template<typename Type>
-                static void write_setting(std::string const& a_strFile, std::string const& a_strElement, Type const& a_tNew, bool a_bMonitor=true);
+                template<typename Type, typename Value>
+                static void write_setting(std::string const& a_strFile, std::string const& a_strElement, Value && a_tNew, bool a_bMonitor=true);
                 /**
                  * @brief Reset a setting element to its default value
                  * @tparam Element      Setting element to reset
@@ -285,6 +891,11 @@ namespace emb {
                  * @param a_funcWrite   Write function
                  */
                 void link_variable_m(std::function<void(void)> const& a_funcRead, std::function<void(void)> const& a_funcWrite);
+                /**
+                 * @brief link a variable refreshed each time the setting element changes. The variable is refreshed immediately
+                 * @param a_funcRefresh Function refreshing the variable from the tree of the file
+                 */
+                void link_pushed_m(std::function<void(boost::property_tree::ptree const&)> const& a_funcRefresh);
                 /**
                  * @brief Link a setting value to a variable
                  * @tparam Type         Type of the setting
@@ -295,6 +906,80 @@ namespace emb {
                  */
                 template<typename Type, typename Element>
                 static void link_setting(std::string const& a_strFile, std::string const& a_strElement, Type& a_rtVariable);
+                /**
+                 * @brief Link a setting value to a variable refreshed each time the setting element is written, reset or reloaded
+                 * @tparam Type         Type of the setting
+                 * @tparam Variable     Type of the variable: \c Type or \c Linked<Type>
+                 * @param a_strFile     Name of the file where the setting element is stored
+                 * @param a_strElement  Name of the setting element in the file
+                 * @param a_funcDecode  Function extracting the setting value from a whole file tree
+                 * @param a_rVariable   Variable to refresh
+                 */
+                template<typename Type, typename Variable>
+                static void link_setting_pushed(std::string const& a_strFile, std::string const& a_strElement, Type (*a_funcDecode)(boost::property_tree::ptree const&), Variable& a_rVariable);
+                /**
+                 * @brief Subscribe to the changes of the setting element caused by a reload of its file
+                 * @param a_funcSubscriber  Function called with the old and new trees of the file
+                 */
+                void subscribe_m(std::function<void(boost::property_tree::ptree const&, boost::property_tree::ptree const&)> const& a_funcSubscriber);
+                /**
+                 * @brief Subscribe to the changes of the sidecar of the setting element
+                 * @param a_funcSubscriber  Function called when the sidecar may have changed, which compares its content itself
+                 */
+                void subscribe_sidecar_m(std::function<void(void)> const& a_funcSubscriber);
+                /**
+                 * @brief Subscribe to the changes of a setting value caused by a reload of its file
+                 * @tparam Type         Type of the setting
+                 * @param a_strFile     Name of the file where the setting element is stored
+                 * @param a_strElement  Name of the setting element in the file
+                 * @param a_funcDecode  Function extracting the setting value from a whole file tree
+                 * @param a_funcCallback Function called with the old and new values, only if they differ
+                 */
+                template<typename Type>
+                static void subscribe_setting(std::string const& a_strFile, std::string const& a_strElement, Type (*a_funcDecode)(boost::property_tree::ptree const&), change_clbk_t<Type> const& a_funcCallback);
+                /**
+                 * @brief Subscribe to the changes of the values of a vector setting element stored with VectorStorage::Sidecar
+                 * @details The sidecar is not part of the tree: its content is compared with the one seen by the previous call
+                 *          when the transaction that wrote it is committed or when it is restored.
+                 * @tparam Type         Type of the values of the setting
+                 * @param a_strFile     Name of the file where the setting element is stored
+                 * @param a_strElement  Name of the setting element in the file
+                 * @param a_tvecDefault Values of the setting when its sidecar does not exist
+                 * @param a_funcCallback Function called with the old and new values, only if they differ
+                 */
+                template<typename Type>
+                static void subscribe_sidecar_setting(std::string const& a_strFile, std::string const& a_strElement, std::vector<Type> const& a_tvecDefault, change_clbk_t<std::vector<Type>> const& a_funcCallback);
+                /**
+                 * @brief Extract a setting value from a file tree
+                 * @tparam Type         Type of the setting
+                 * @param a_Tree        Tree of the file
+                 * @param a_strKey      Key of the setting element in the file
+                 * @param a_tDefault    Default value to return if the setting element is not found in the tree
+                 * @return Type         Value or \c a_tDefault it not found
+                 */
+                template<typename Type>
+                static Type value_from_tree(boost::property_tree::ptree const& a_Tree, std::string const& a_strKey, Type const& a_tDefault);
+                /**
+                 * @brief Extract a vector setting value from a file tree
+                 * @tparam Type         Base type of the setting
+                 * @tparam _Storage     Storage of the values in the file
+                 * @param a_Tree        Tree of the file
+                 * @param a_strKey      Key of the setting element in the file
+                 * @param a_tvecDefault Default value to return if the setting element is not found in the tree
+                 * @return std::vector<Type> Value or \c a_tvecDefault it not found
+                 */
+                template<typename Type, VectorStorage _Storage = VectorStorage::Nodes>
+                static std::vector<Type> vector_from_tree(boost::property_tree::ptree const& a_Tree, std::string const& a_strKey, std::vector<Type> const& a_tvecDefault);
+                /**
+                 * @brief Extract a map setting value from a file tree
+                 * @tparam Type         Base type of the setting
+                 * @param a_Tree        Tree of the file
+                 * @param a_strKey      Key of the setting element in the file
+                 * @param a_tmapDefault Default value to return if the setting element is not found in the tree
+                 * @return std::map<std::string, Type> Value or \c a_tmapDefault it not found
+                 */
+                template<typename Type>
+                static std::map<std::string, Type> map_from_tree(boost::property_tree::ptree const& a_Tree, std::string const& a_strKey, std::map<std::string, Type> const& a_tmapDefault);
                 /**
                  * @brief
                  *
@@ -304,7 +989,7 @@ namespace emb {
                  * @param a_tvecDefault Default value to return if the setting element is not found in file
                  * @return std::vector<Type>
                  */
-                template<typename Type>
+                template<typename Type, VectorStorage _Storage = VectorStorage::Nodes>
                 static std::vector<Type> read_setting_vector(std::string const& a_strFile, std::string const& a_strElement, std::vector<Type> const& a_tvecDefault);
                 /**
                  * @brief
@@ -312,10 +997,10 @@ namespace emb {
                  * @tparam Type
                  * @param a_strFile
                  * @param a_strElement  Name of the setting element in the file
-                 * @param a_tvecNew
+                 * @param a_tvecNew     Values to write, moved into the tree if it is an rvalue
                  */
-                template<typename Type>
-                static void write_setting_vector(std::string const& a_strFile, std::string const& a_strElement, std::vector<Type> const& a_tvecNew);
+                template<typename Type, VectorStorage _Storage = VectorStorage::Nodes, typename Values>
+                static void write_setting_vector(std::string const& a_strFile, std::string const& a_strElement, Values && a_tvecNew);
                 /**
                  * @brief
                  *
@@ -324,7 +1009,7 @@ namespace emb {
                  * @param a_strElement  Name of the setting element in the file
                  * @param a_tNew
                  */
-                template<typename Type>
+                template<typename Type, VectorStorage _Storage = VectorStorage::Nodes>
                 static void add_setting_vector(std::string const& a_strFile, std::string const& a_strElement, Type const& a_tNew);
                 /**
                  * @brief Reset a vector setting element to its default value
@@ -341,6 +1026,41 @@ namespace emb {
                  */
                 template<typename Element>
                 static bool is_default_setting_vector();
+                /**
+                 * @brief Get the number of values of a vector setting element
+                 * @tparam Element      Vector setting element
+                 * @return std::size_t  Number of values, the ones of the default value if not found in file
+                 */
+                template<typename Element>
+                static std::size_t size_setting_vector();
+                /**
+                 * @brief Read a vector setting element into an existing vector, reusing its capacity and the one of its strings
+                 * @tparam Element      Vector setting element
+                 * @param a_rtvecOutput Values of the setting element, the ones of the default value if not found in file
+                 */
+                template<typename Element>
+                static void read_into_setting_vector(typename Element::Type & a_rtvecOutput);
+                /**
+                 * @brief Read a single value of a vector setting element. With VectorStorage::Nodes, only the previous nodes are walked.
+                 * @tparam Element      Vector setting element
+                 * @param a_uIndex      Position of the value
+                 * @return std::optional<typename Element::Type::value_type> Value, or std::nullopt if out of range
+                 */
+                template<typename Element>
+                static std::optional<typename Element::Type::value_type> at_setting_vector(std::size_t a_uIndex);
+                /**
+                 * @brief Modify the values of a vector setting element in place
+                 * @details With VectorStorage::Nodes, \c a_funcModify is called on the node of the element, whose children are the values.
+                 *          The other storages are read, modified and written back.
+                 *          A vector absent from the file is first initialized with its default value.
+                 * @tparam Element      Vector setting element
+                 * @param a_funcNodes   Function modifying the node: bool(ptree& a_rNode, std::string const& a_strChildKey)
+                 * @param a_funcValues  Function modifying the values of the other storages: bool(std::vector<value_type>&)
+                 * @return true         The values have been modified
+                 * @return false        The modification failed (e.g. out of range), nothing is changed
+                 */
+                template<typename Element, typename FuncNodes, typename FuncValues>
+                static bool modify_setting_vector(FuncNodes && a_funcNodes, FuncValues && a_funcValues);
                 /**
                  * @brief
                  *
@@ -358,10 +1078,10 @@ namespace emb {
                  * @tparam Type
                  * @param a_strFile
                  * @param a_strElement  Name of the setting element in the file
-                 * @param a_tmapNew
+                 * @param a_tmapNew     Values to write, moved into the tree if it is an rvalue
                  */
-                template<typename Type>
-                static void write_setting_map(std::string const& a_strFile, std::string const& a_strElement, std::map<std::string, Type> const& a_tmapNew);
+                template<typename Type, typename Values>
+                static void write_setting_map(std::string const& a_strFile, std::string const& a_strElement, Values && a_tmapNew);
                 /**
                  * @brief Set the setting map object
                  *
@@ -388,18 +1108,64 @@ namespace emb {
                  */
                 template<typename Element>
                 static bool is_default_setting_map();
+                /**
+                 * @brief Read a single value of a map setting element, found by key in the subtree without reading the others
+                 * @tparam Element      Map setting element
+                 * @param a_strK        Key of the value in the map
+                 * @return std::optional<typename Element::Type::mapped_type> Value, or std::nullopt if the key is absent
+                 */
+                template<typename Element>
+                static std::optional<typename Element::Type::mapped_type> get_setting_map(std::string const& a_strK);
+                /**
+                 * @brief Get the number of values of a map setting element
+                 * @tparam Element      Map setting element
+                 * @return std::size_t  Number of values, the ones of the default value if not found in file
+                 */
+                template<typename Element>
+                static std::size_t size_setting_map();
+                /**
+                 * @brief Read a map setting element into an existing map, reusing the nodes of the keys still present and their strings
+                 * @tparam Element      Map setting element
+                 * @param a_rtmapOutput Values of the setting element, the ones of the default value if not found in file
+                 */
+                template<typename Element>
+                static void read_into_setting_map(typename Element::Type & a_rtmapOutput);
+                /**
+                 * @brief Remove a single value from a map setting element
+                 * @details A map absent from the file is written with its default value, without the removed key
+                 * @tparam Element      Map setting element
+                 * @param a_strK        Key of the value in the map
+                 * @return true         The value has been removed
+                 * @return false        The key is absent
+                 */
+                template<typename Element>
+                static bool erase_setting_map(std::string const& a_strK);
 
                 /**
                  * @brief
                  */
                 virtual void _register_() noexcept = 0;
+                /**
+                 * @brief Register a setting element during the static initialization, without creating an instance of it
+                 * @param a_szFile              Name of the settings file
+                 * @param a_szElement           Name of the setting element
+                 * @param a_szKey               Key of the setting element
+                 * @param a_funcCreationMethod  Function creating an instance of the setting element
+                 */
+                static bool register_element(char const* a_szFile, char const* a_szElement, char const* a_szKey, creation_method<SettingElement> a_funcCreationMethod);
+                /**
+                 * @brief Register a setting element, creating an instance of it to get its key
+                 * @param a_szFile              Name of the settings file
+                 * @param a_szElement           Name of the setting element
+                 * @param a_funcCreationMethod  Function creating an instance of the setting element
+                 */
                 static bool register_element(char const* a_szFile, char const* a_szElement, creation_method<SettingElement> a_funcCreationMethod);
 
             private:
-                std::string const m_strName;
-                std::string const m_strType;
-                std::string const m_strFile;
-                std::string const m_strKey;
+                std::string_view const m_strName;   ///< Interned
+                std::string_view const m_strType;   ///< Interned
+                std::string_view const m_strFile;   ///< Interned
+                std::string_view const m_strKey;    ///< Interned
             };
 
             /**
@@ -423,6 +1189,7 @@ namespace emb {
                 using File = _File;
                 static char const* Key;
                 static _Type const Default;
+                static constexpr bool Hot{ false };     ///< Hidden by \c true in the elements declared with EMBSETTINGS_HOT_SCALAR
 
             // public methods
             public:
@@ -439,11 +1206,23 @@ namespace emb {
                  * @return Type     Value of the setting element
                  */
                 static _Type read();
+                /**
+                 * @brief Read the setting element through a read guard of its file, without locking nor copying strings
+                 * @details Reads are not reported to the monitoring callback
+                 * @param a_Guard   Read guard of the file of the setting element, asserted in debug builds
+                 * @return ViewType<_Type> Value of the setting element, valid as long as the guard
+                 */
+                static ViewType<_Type> view(ReadGuard const& a_Guard);
                 /**
                  * @brief Write the setting element
                  * @param a_tVal    New value of the setting element
                  */
                 static void write(_Type const& a_tVal);
+                /**
+                 * @brief Write the setting element, moving the value into the tree (strings)
+                 * @param a_tVal    New value of the setting element
+                 */
+                static void write(_Type&& a_tVal);
                 /**
                  * @brief Reset the setting element to its default value
                  */
@@ -458,8 +1237,22 @@ namespace emb {
                  * @brief Link the setting element to a variable
                  *
                  * @param a_rtVar   Variable to link the setting element to
+                 * @param a_eMode   With LinkMode::AutoRefresh, the variable is also updated in place (in the thread writing
+                 *                  or reloading the setting element, with the file locked) each time it changes
+                 */
+                static void link(_Type& a_rtVar, LinkMode a_eMode = LinkMode::OnDemand);
+                /**
+                 * @brief Link the setting element to a variable refreshed each time it is written, reset or reloaded
+                 * @param a_rVar    Variable to link the setting element to, readable from any thread
+                 */
+                static void link(Linked<_Type>& a_rVar);
+                /**
+                 * @brief Subscribe to the changes of the setting element caused by a reload of its file
+                 * @details The callback is called, with the file locked, when a restore, an external modification
+                 *          (see \c start_file_watcher) or a transaction commit changes the value seen by the readers
+                 * @param a_funcCallback Function called with the old and new values of the setting element
                  */
-                static void link(_Type& a_rtVar);
+                static void subscribe(change_clbk_t<_Type> const& a_funcCallback);
                 /**
                  * @brief Read the setting element as a string
                  * @return std::string Value of the element
@@ -488,10 +1281,23 @@ namespace emb {
                  * @return std::unique_ptr<SettingsElement> Newly created object
                  */
                 static std::unique_ptr<SettingElement> _create_();
+                /**
+                 * @brief Extract the value of the setting element from a file tree
+                 * @param a_Tree    Tree of the file
+                 * @return Type     Value of the setting element
+                 */
+                static Type from_tree(boost::property_tree::ptree const& a_Tree);
+                /**
+                 * @brief Register the hot mirror as a linked variable, which initializes it
+                 */
+                static void prime_hot_mirror();
 
             // protected attributes
             protected:
                 static bool s_bRegistered;
+                /// Mirror of the hot scalars, never instantiated for the types that cannot be mirrored (e.g. std::string)
+                using HotMirror = std::conditional_t<std::is_trivially_copyable_v<_Type>, THotMirror<_Type>, std::nullptr_t>;
+                static HotMirror s_hotMirror;   ///< Only used by hot scalars
             };
 
             /**
@@ -515,6 +1321,7 @@ namespace emb {
                 using File = _File;
                 static char const* Key;
                 static Type const Default;
+                static constexpr VectorStorage Storage{ VectorStorage::Nodes };    ///< Hidden in the elements declared with a storage
 
             // public methods
             public:
@@ -531,16 +1338,75 @@ namespace emb {
                  * @return Type     Value of the setting element
                  */
                 static std::vector<_Type> read();
+                /**
+                 * @brief Read the vector setting element into an existing vector
+                 * @details The capacity of the vector and of its strings is reused: reading periodically a vector whose
+                 *          size does not grow does not allocate
+                 * @param a_rtvecVal Value of the setting element
+                 */
+                static void read_into(std::vector<_Type>& a_rtvecVal);
                 /**
                  * @brief Write the vector setting element
                  * @param a_tvecVal New value of the setting element
                  */
                 static void write(std::vector<_Type> const& a_tvecVal);
+                /**
+                 * @brief Write the vector setting element, moving the values into the tree (strings)
+                 * @param a_tvecVal New value of the vector setting element
+                 */
+                static void write(std::vector<_Type>&& a_tvecVal);
                 /**
                  * @brief Add a value to the vector setting element
                  * @param a_tVal    New value of the setting element
                  */
                 static void add(_Type const& a_tVal);
+                /**
+                 * @brief Get a view on the values of a vector setting element stored with VectorStorage::Sidecar, without copy
+                 * @details The view stays valid after the setting element is written: it then keeps seeing the previous values
+                 * @return ArrayView<_Type> View on the mapped sidecar file, or on the default value if it does not exist
+                 */
+                static ArrayView<_Type> view();
+                /**
+                 * @brief Iterate over the values of the vector setting element through a read guard of its file, without allocation
+                 * @details Requires VectorStorage::Nodes. Reads are not reported to the monitoring callback
+                 * @param a_Guard   Read guard of the file of the setting element, asserted in debug builds
+                 * @return ChildrenView<_Type, false> Values of the setting element, valid as long as the guard
+                 */
+                static ChildrenView<_Type, false> view(ReadGuard const& a_Guard);
+                /**
+                 * @brief Get the number of values of the vector setting element, without reading them
+                 * @return std::size_t  Number of values
+                 */
+                static std::size_t size();
+                /**
+                 * @brief Read a single value of the vector setting element
+                 * @param a_uIndex  Position of the value
+                 * @return std::optional<_Type> Value, or std::nullopt if \c a_uIndex is out of range
+                 */
+                static std::optional<_Type> at(std::size_t a_uIndex);
+                /**
+                 * @brief Replace a single value of the vector setting element, in place
+                 * @param a_uIndex  Position of the value
+                 * @param a_tVal    New value
+                 * @return true     The value has been replaced
+                 * @return false    \c a_uIndex is out of range
+                 */
+                static bool set_at(std::size_t a_uIndex, _Type const& a_tVal);
+                /**
+                 * @brief Insert a single value in the vector setting element, in place
+                 * @param a_uIndex  Position of the new value, up to size()
+                 * @param a_tVal    New value
+                 * @return true     The value has been inserted
+                 * @return false    \c a_uIndex is out of range
+                 */
+                static bool insert_at(std::size_t a_uIndex, _Type const& a_tVal);
+                /**
+                 * @brief Remove a single value from the vector setting element, in place
+                 * @param a_uIndex  Position of the value
+                 * @return true     The value has been removed
+                 * @return false    \c a_uIndex is out of range
+                 */
+                static bool erase_at(std::size_t a_uIndex);
                 /**
                  * @brief Reset the vector setting element to its default value
                  */
@@ -555,8 +1421,22 @@ namespace emb {
                  * @brief Link the vector setting element to a vector variable
                  *
                  * @param a_rtvecVal Variable to link the setting element to
+                 * @param a_eMode   With LinkMode::AutoRefresh, the variable is also updated in place (in the thread writing
+                 *                  or reloading the setting element, with the file locked) each time it changes
+                 */
+                static void link(std::vector<_Type>& a_rtvecVal, LinkMode a_eMode = LinkMode::OnDemand);
+                /**
+                 * @brief Link the setting element to a variable refreshed each time it is written, reset or reloaded
+                 * @param a_rVar    Variable to link the setting element to, readable from any thread
                  */
-                static void link(std::vector<_Type>& a_rtvecVal);
+                static void link(Linked<std::vector<_Type>>& a_rVar);
+                /**
+                 * @brief Subscribe to the changes of the vector setting element caused by a reload of its file
+                 * @details The callback is called, with the file locked, when a restore, an external modification
+                 *          (see \c start_file_watcher) or a transaction commit changes the value seen by the readers
+                 * @param a_funcCallback Function called with the old and new values of the setting element
+                 */
+                static void subscribe(change_clbk_t<Type> const& a_funcCallback);
                 /**
                  * @brief Read the setting element as a string
                  * @return std::string Value of the element
@@ -585,6 +1465,12 @@ namespace emb {
                  * @return std::unique_ptr<SettingsElement> Newly created object
                  */
                 static std::unique_ptr<SettingElement> _create_();
+                /**
+                 * @brief Extract the value of the setting element from a file tree
+                 * @param a_Tree    Tree of the file
+                 * @return Type     Value of the setting element
+                 */
+                static Type from_tree(boost::property_tree::ptree const& a_Tree);
 
             // protected attributes
             protected:
@@ -628,17 +1514,61 @@ namespace emb {
                   * @return Type     Value of the map setting element
                   */
                 static std::map<std::string, _Type> read();
+                /**
+                  * @brief Read the map setting element into an existing map
+                  * @details The nodes of the keys still present and the capacity of their strings are reused: reading
+                  *          periodically a map whose keys do not change does not allocate
+                  * @param a_rtmapVal Value of the map setting element
+                  */
+                static void read_into(std::map<std::string, _Type>& a_rtmapVal);
+                /**
+                  * @brief Iterate over the keys and values of the map setting element through a read guard of its file, without allocation
+                  * @details Reads are not reported to the monitoring callback
+                  * @param a_Guard   Read guard of the file of the setting element, asserted in debug builds
+                  * @return ChildrenView<_Type, true> Keys and values of the setting element, valid as long as the guard
+                  */
+                static ChildrenView<_Type, true> view(ReadGuard const& a_Guard);
                 /**
                   * @brief Write the map setting element
                   * @param a_tmapVal New value of the map setting element
                   */
                 static void write(std::map<std::string, _Type> const& a_tmapVal);
+                /**
+                  * @brief Write the map setting element, moving the values into the tree (strings)
+                  * @param a_tmapVal New value of the map setting element
+                  */
+                static void write(std::map<std::string, _Type>&& a_tmapVal);
                 /**
                   * @brief Set the map setting element value at a given key
                   * @param a_strKey  Key of the map setting element
                   * @param a_tVal    New value of map the setting element
                   */
                 static void set(std::string const& a_strKey, _Type const& a_tVal);
+                /**
+                 * @brief Read the map setting element value at a given key, without reading the other values
+                 * @param a_strKey  Key of the map setting element
+                 * @return std::optional<_Type> Value, or std::nullopt if the key is absent
+                 */
+                static std::optional<_Type> get(std::string const& a_strKey);
+                /**
+                 * @brief Indicate if the map setting element has a value at a given key
+                 * @param a_strKey  Key of the map setting element
+                 * @return true     The key is present
+                 * @return false    Otherwise
+                 */
+                static bool contains(std::string const& a_strKey);
+                /**
+                 * @brief Remove the map setting element value at a given key
+                 * @param a_strKey  Key of the map setting element
+                 * @return true     The value has been removed
+                 * @return false    The key is absent
+                 */
+                static bool erase(std::string const& a_strKey);
+                /**
+                 * @brief Get the number of values of the map setting element, without reading them
+                 * @return std::size_t  Number of values
+                 */
+                static std::size_t size();
                 /**
                  * @brief Reset the map setting element to its default value
                  */
@@ -653,8 +1583,22 @@ namespace emb {
                  * @brief Link the setting element to a variable
                  *
                  * @param a_rtmapVal Variable to link the setting element to
+                 * @param a_eMode   With LinkMode::AutoRefresh, the variable is also updated in place (in the thread writing
+                 *                  or reloading the setting element, with the file locked) each time it changes
+                 */
+                static void link(std::map<std::string, _Type>& a_rtmapVal, LinkMode a_eMode = LinkMode::OnDemand);
+                /**
+                 * @brief Link the setting element to a variable refreshed each time it is written, reset or reloaded
+                 * @param a_rVar    Variable to link the setting element to, readable from any thread
                  */
-                static void link(std::map<std::string, _Type>& a_rtmapVal);
+                static void link(Linked<std::map<std::string, _Type>>& a_rVar);
+                /**
+                 * @brief Subscribe to the changes of the map setting element caused by a reload of its file
+                 * @details The callback is called, with the file locked, when a restore, an external modification
+                 *          (see \c start_file_watcher) or a transaction commit changes the value seen by the readers
+                 * @param a_funcCallback Function called with the old and new values of the setting element
+                 */
+                static void subscribe(change_clbk_t<Type> const& a_funcCallback);
                 /**
                  * @brief Read the setting element as a string
                  * @return std::string Value of the element
@@ -676,6 +1620,98 @@ namespace emb {
                  */
                 void reset_m() const override;
 
+            // protected methods
+            protected:
+                /**
+                  * @brief Create an object of type \c Name
+                  * @return std::unique_ptr<SettingsElement> Newly created object
+                  */
+                static std::unique_ptr<SettingElement> _create_();
+                /**
+                 * @brief Extract the value of the setting element from a file tree
+                 * @param a_Tree    Tree of the file
+                 * @return Type     Value of the setting element
+                 */
+                static Type from_tree(boost::property_tree::ptree const& a_Tree);
+
+            // protected attributes
+            protected:
+                static bool s_bRegistered;
+            };
+
+            /**
+             * @brief Base class of a table setting element
+             *
+             * @tparam Name         Class name of the element
+             * @tparam NameStr      Class name of the element, as a string
+             * @tparam Record       Type of the rows of the element
+             * @tparam TypeStr      Type of the element, as a string
+             * @tparam File         Class name of the file when the element must be stored
+             * @tparam KeyStr       Key locating the element inside the file
+             * @tparam KeyField     Field of the rows used as primary key
+             */
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            class TSettingTable
+                    : public SettingElement {
+                static_assert(FileType::INI != _File::Type, "Tables cannot be stored in INI files");
+            // public attributes
+            public:
+                static char const* Name;
+                using Type = Table<_Record, _KeyField>;
+                using File = _File;
+                static char const* Key;
+                static Type const Default;
+
+            // public methods
+            public:
+                /**
+                 * @brief Construct a new TSettingTable object
+                 */
+                TSettingTable();
+                /**
+                 * @brief Destroy the TSettingTable object
+                 */
+                virtual ~TSettingTable();
+                /**
+                 * @brief Read the table setting element, in one locked pass
+                 * @return Type     Value of the table setting element
+                 */
+                static Type read();
+                /**
+                 * @brief Write the table setting element, with one node per row
+                 * @param a_Val     New value of the table setting element
+                 */
+                static void write(Type const& a_Val);
+                /**
+                 * @brief Reset the table setting element to its default value
+                 */
+                static void reset();
+                /**
+                 * @brief Indicate if table setting element has its default value
+                 * @return true     The table setting element has its default value
+                 * @return false    Otherwise
+                 */
+                static bool is_default();
+                /**
+                 * @brief Read the setting element as a string
+                 * @return std::string Value of the element
+                 */
+                std::string read_str_m() const override;
+                /**
+                 * @brief Write the setting element as a string, not supported by tables: the string is ignored
+                 */
+                void write_str_m(std::string const&) const override {}
+                /**
+                 * @brief Indicate if the setting element has its default value
+                 * @return true     the setting element has its default value
+                 * @return false    otherwise
+                 */
+                bool is_default_m() const override;
+                /**
+                 * @brief Reset the setting element to its default value
+                 */
+                void reset_m() const override;
+
             // protected methods
             protected:
                 /**
@@ -697,9 +1733,9 @@ namespace emb {
             public:
                 /**
                  * @brief Get the settings file's name
-                 * @return std::string  Name of the settings file
+                 * @return std::string_view  Name of the settings file, interned
                  */
-                std::string get_name_m() const;
+                std::string_view get_name_m() const;
                 /**
                  * @brief Get the settings file's type
                  * @return std::string  Type of the settings file
@@ -739,7 +1775,7 @@ namespace emb {
                  * @param a_iVersion
                  * @param a_pVersionClbk
                  */
-                SettingsFile(std::string const& a_strName, FileType a_eType, std::string const& a_strPath, int a_iVersion, version_clbk_t a_pVersionClbk);
+                SettingsFile(std::string_view a_strName, FileType a_eType, std::string const& a_strPath, int a_iVersion, version_clbk_t a_pVersionClbk);
                 /**
                  * @brief Destroy the Settings File object
                  *
@@ -749,11 +1785,23 @@ namespace emb {
                  * @brief
                  */
                 virtual void _register_() noexcept = 0;
+                /**
+                 * @brief Register a settings file during the static initialization, without creating an instance of it
+                 * @param a_szFile              Name of the settings file
+                 * @param a_eType               Type of the settings file
+                 * @param a_funcCreationMethod  Function creating an instance of the settings file
+                 */
+                static bool register_file(char const* a_szFile, FileType a_eType, creation_method<SettingsFile> a_funcCreationMethod);
+                /**
+                 * @brief Register a settings file, creating an instance of it to get its type
+                 * @param a_szFile              Name of the settings file
+                 * @param a_funcCreationMethod  Function creating an instance of the settings file
+                 */
                 static bool register_file(char const* a_szFile, creation_method<SettingsFile> a_funcCreationMethod);
 
             // private attributes
             private:
-                std::string const m_strName;
+                std::string_view const m_strName;   ///< Interned
                 FileType const m_eType;
                 std::string const m_strPath;
                 int const m_iVersion;
@@ -777,7 +1825,7 @@ namespace emb {
             public:
                 static char const* Name;
                 static char const* Path;
-                static emb::settings::FileType const Type;
+                static constexpr emb::settings::FileType Type{ _Type };
                 static int const Version;
                 static version_clbk_t const VersionClbk;
 
@@ -802,6 +1850,13 @@ namespace emb {
                  *          The property tree is restored to the value is had before the \c begin call.
                  */
                 static void abort();
+                /**
+                 * @brief Lock the settings file for reading, to view its setting elements without copying them
+                 * @details The writers of the file are blocked as long as the guard exists, which must be released by the thread
+                 *          that created it. During a transaction, the guard sees the values before the \c begin call.
+                 * @return ReadGuard Guard to give to the \c view methods of the setting elements of the file
+                 */
+                static ReadGuard view();
                 static void read_linked();
                 static void write_linked();
                 static bool backup_to(std::string const& a_strFolderName);
@@ -822,18 +1877,141 @@ namespace emb {
                 static bool s_bRegistered;
             };
 
+            struct SettingsFileInfo;
             struct tree_ptr_deleter {
+                SettingsFileInfo* pFileInfo{nullptr};   ///< File to unlock when the tree is released
                 void operator()(boost::property_tree::ptree* a_pObj);
             };
             using tree_ptr = std::unique_ptr<boost::property_tree::ptree, tree_ptr_deleter>;
             tree_ptr get_tree(std::string const& a_strFileName, std::string const& a_strElementName, bool a_bReadOnly);
+            /**
+             * @brief Get the locked tree of a settings file, whatever the setting element
+             * @param a_strFileName Name of the settings file
+             * @param a_bReadOnly   The tree is only read
+             * @return tree_ptr     Locked tree, nullptr if the file is unknown
+             */
+            tree_ptr get_file_tree(std::string const& a_strFileName, bool a_bReadOnly);
             boost::optional<boost::property_tree::ptree&> get_sub_tree(tree_ptr const& a_pTree, std::string const& a_strKey, bool a_bCreate = false);
+            /**
+             * @brief Refresh the variables linked in LinkMode::AutoRefresh to a setting element that has just been modified
+             * @param a_pTree           Locked tree of the file
+             * @param a_strElementName  Name of the modified setting element
+             */
+            void push_linked(tree_ptr const& a_pTree, std::string const& a_strElementName);
+
+            /**
+             * @brief Intern a string: equal strings share the same storage, kept for the program lifetime
+             * @details Two interned strings are equal if and only if their data pointers are equal.
+             *          Used for the names and keys of the registry and of the monitoring information, which the compact trees reuse.
+             * @param a_strValue        String to intern
+             * @return std::string_view Interned string
+             */
+            std::string_view intern(std::string_view a_strValue);
+            /**
+             * @brief Get the interned version of a string, without interning it
+             * @param a_strValue        String to look for
+             * @return std::string_view Interned string, or an empty view whose data pointer is null if never interned
+             */
+            std::string_view find_interned(std::string_view a_strValue);
+
+            /**
+             * @brief Count a reset in the performance counters of a settings file
+             * @param a_strFileName Name of the settings file
+             */
+            void count_reset(std::string const& a_strFileName);
+
+            /**
+             * @brief Get the key of a registered setting element, without creating an instance of it
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             * @return std::string_view Interned key, empty if the element is unknown
+             */
+            std::string_view get_element_key(std::string_view a_strFileName, std::string_view a_strElementName);
+            /**
+             * @brief Get the interned names of a registered setting element, without locking the table of the interned strings
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             * @return std::pair        Interned names of the file and of the element, interned on the call if the element is unknown
+             */
+            std::pair<std::string_view, std::string_view> get_element_names(std::string_view a_strFileName, std::string_view a_strElementName);
+            /**
+             * @brief Get the type of a registered settings file, without creating an instance of it
+             * @param a_strFileName     Name of the settings file
+             * @return FileType         Type of the file, FileType::XML if the file is unknown
+             */
+            emb::settings::FileType get_file_type(std::string_view a_strFileName);
 
             std::string& xml_vector_element_name();
             emb::settings::DefaultMode& default_mode();
+            /**
+             * @brief Tell if a monitoring callback is set, to avoid stringifying values nobody will see
+             */
+            bool has_monitoring_callback();
             void call_monitoring_callback(emb::settings::MonitoringInformation const& a_stInformation);
             void remove_tree(boost::property_tree::ptree & a_rTree, std::string const& a_strKeyToRemove);
             std::string stringify_tree(boost::property_tree::ptree const& a_Tree);
+            /**
+             * @brief Count the separators of values stored with VectorStorage::Packed, to reserve the vector before parsing
+             * @details Uses AVX2 (when supported by the CPU) or NEON, with a scalar fallback
+             * @param a_strPacked   Packed values
+             * @return std::size_t  Number of whitespaces (as std::isspace in the "C" locale) in \c a_strPacked
+             */
+            std::size_t count_packed_separators(std::string const& a_strPacked);
+            /**
+             * @brief Append a field to a row of a table setting element, escaping the separators
+             * @param a_rstrRow     Row, fields separated by ';'
+             * @param a_strCell     Value of the field
+             */
+            void append_table_cell(std::string & a_rstrRow, std::string const& a_strCell);
+            /**
+             * @brief Split a row of a table setting element into its fields
+             * @param a_strRow      Row, fields separated by ';'
+             * @param a_rvecCells   Values of the fields, unescaped (the vector and its strings are reused)
+             */
+            void split_table_row(std::string const& a_strRow, std::vector<std::string> & a_rvecCells);
+
+            /**
+             * @brief Values of a vector setting element stored with VectorStorage::Sidecar
+             */
+            struct SidecarContent {
+                void const* pData{nullptr};     ///< First value
+                std::size_t uElementSize{0};    ///< Size of each value
+                std::size_t uCount{0};          ///< Number of values
+            };
+            /**
+             * @brief Get the sidecar file of a vector setting element, mapped in memory
+             * @details During a transaction, the readers do not see the values written by the transaction (like for the other elements)
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             * @param a_uElementSize    Expected size of each value
+             * @param a_bWriterView     Also see the values written by the pending transaction, to modify them
+             * @return std::shared_ptr<SidecarContent const> Mapped content, nullptr if the sidecar does not exist or does not match
+             */
+            std::shared_ptr<SidecarContent const> read_sidecar(std::string const& a_strFileName, std::string const& a_strElementName, std::size_t a_uElementSize, bool a_bWriterView = false);
+            /**
+             * @brief Write the sidecar file of a vector setting element (atomically replaced), or keep it until the commit of a transaction
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             * @param a_pData           First value
+             * @param a_uElementSize    Size of each value
+             * @param a_uCount          Number of values
+             * @return true             The sidecar has been written or is pending
+             * @return false            The sidecar could not be written
+             */
+            bool write_sidecar(std::string const& a_strFileName, std::string const& a_strElementName, void const* a_pData, std::size_t a_uElementSize, std::size_t a_uCount);
+            /**
+             * @brief Remove the sidecar file of a vector setting element, or at the commit of a transaction
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             */
+            void remove_sidecar(std::string const& a_strFileName, std::string const& a_strElementName);
+            /**
+             * @brief Get the name of the sidecar file of a vector setting element, as referenced from the settings file
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             * @return std::string      Name of the sidecar file, in the directory of the settings file
+             */
+            std::string sidecar_file_name(std::string const& a_strFileName, std::string const& a_strElementName);
 
             /**
             * @brief Backs the current file up
@@ -859,6 +2037,75 @@ namespace emb {
             void abort_file_transaction(std::string const& a_strFileName);
         }
 
+        /**
+         * @brief Read lock of a settings file, given by the \c view method of the file
+         * @details The views given by the setting elements borrow their data from the locked tree: they must not outlive the guard
+         */
+        class ReadGuard {
+        public:
+            ReadGuard() = default;
+            ReadGuard(char const* a_szFileName, internal::tree_ptr a_pTree)
+                : m_szFileName{ a_szFileName }, m_pTree{ std::move(a_pTree) } {}
+            /**
+             * @brief Indicate if the guard holds the lock of a file
+             */
+            explicit operator bool() const { return static_cast<bool>(m_pTree); }
+            /**
+             * @brief Get the locked tree
+             * @details Reading a setting element through the guard of another file is a programming error
+             * @param a_szFileName  Name of the settings file of the caller
+             * @return boost::property_tree::ptree const* Locked tree, nullptr if the guard does not hold a lock
+             */
+            boost::property_tree::ptree const* tree(char const* a_szFileName) const {
+                assert((!m_pTree || a_szFileName == m_szFileName) && "The read guard is not the one of the file of the setting element");
+                return a_szFileName == m_szFileName ? m_pTree.get() : nullptr;
+            }
+
+        private:
+            char const* m_szFileName{nullptr};
+            internal::tree_ptr m_pTree{};
+        };
+
+        /**
+         * @brief Range over the children of a node of a locked tree, converting each value when dereferenced
+         * @tparam T        Type of the values
+         * @tparam _Keyed   Values are seen as std::pair<std::string_view, ViewType<T>> with the key of their node (maps)
+         */
+        template<typename T, bool _Keyed>
+        class ChildrenView {
+        public:
+            using value_type = std::conditional_t<_Keyed, std::pair<std::string_view, ViewType<T>>, ViewType<T>>;
+
+            class iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename ChildrenView::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = value_type;
+
+                iterator() = default;
+                explicit iterator(boost::property_tree::ptree::const_iterator a_it) : m_it{ a_it } {}
+                value_type operator*() const;
+                iterator& operator++() { ++m_it; return *this; }
+                iterator operator++(int) { iterator itOld{ *this }; ++m_it; return itOld; }
+                bool operator==(iterator const& a_Other) const { return m_it == a_Other.m_it; }
+                bool operator!=(iterator const& a_Other) const { return m_it != a_Other.m_it; }
+
+            private:
+                boost::property_tree::ptree::const_iterator m_it{};
+            };
+
+            explicit ChildrenView(boost::property_tree::ptree const& a_Node) : m_pNode{ &a_Node } {}
+            iterator begin() const { return iterator{ m_pNode->begin() }; }
+            iterator end() const { return iterator{ m_pNode->end() }; }
+            std::size_t size() const { return m_pNode->size(); }
+            bool empty() const { return m_pNode->empty(); }
+
+        private:
+            boost::property_tree::ptree const* m_pNode{nullptr};
+        };
+
         /**
          * @brief Get the file object
          *
@@ -2,6 +2,13 @@
 //#define DEBUG_REGISTER
 #include "EmbSettings.hpp"
 #include <string>
+#include <cstring>
+#include <mutex>
+#include <charconv>
+#include <istream>
+#include <string_view>
+#include <cctype>
+#include <algorithm>
 #ifdef DEBUG_REGISTER
 #include <iostream>
 #endif
@@ -9,41 +16,483 @@
 
 namespace emb {
     namespace settings {
+
+        //////////////////////////////////////////////////
+        ///// TSeqLock / TLockFreeValue              /////
+        //////////////////////////////////////////////////
+
+        template<typename T>
+        T internal::TSeqLock<T>::load() const {
+            std::uint64_t auWords[s_uWords];
+            std::uint32_t uBefore{}, uAfter{};
+            do {
+                uBefore = m_uSequence.load(std::memory_order_acquire);
+                for(std::size_t i = 0; i < s_uWords; ++i) {
+                    auWords[i] = m_auWords[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                uAfter = m_uSequence.load(std::memory_order_relaxed);
+            } while((uBefore & 1) || uBefore != uAfter);
+            T tValue{};
+            std::memcpy(&tValue, auWords, sizeof(T));
+            return tValue;
+        }
+
+        template<typename T>
+        void internal::TSeqLock<T>::store(T const& a_tValue) {
+            std::uint64_t auWords[s_uWords]{};
+            std::memcpy(auWords, &a_tValue, sizeof(T));
+            auto const uSequence = m_uSequence.load(std::memory_order_relaxed);
+            m_uSequence.store(uSequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for(std::size_t i = 0; i < s_uWords; ++i) {
+                m_auWords[i].store(auWords[i], std::memory_order_relaxed);
+            }
+            m_uSequence.store(uSequence + 2, std::memory_order_release);
+        }
+
+        template<typename T>
+        T internal::TLockFreeValue<T>::load() const {
+            if constexpr (s_bAtomic) {
+                return m_value.load(std::memory_order_acquire);
+            }
+            else {
+                return m_value.load();
+            }
+        }
+
+        template<typename T>
+        void internal::TLockFreeValue<T>::store(T const& a_tValue) {
+            if constexpr (s_bAtomic) {
+                m_value.store(a_tValue, std::memory_order_release);
+            }
+            else {
+                m_value.store(a_tValue);
+            }
+        }
+
+        //////////////////////////////////////////////////
+        ///// Linked                                 /////
+        //////////////////////////////////////////////////
+
+        template<typename T>
+        Linked<T, true>::Linked() {
+            store(T{});
+        }
+
+        template<typename T>
+        Linked<T, true>::Linked(T const& a_tValue) {
+            store(a_tValue);
+        }
+
+        template<typename T>
+        T Linked<T, true>::load() const {
+            return m_value.load();
+        }
+
+        template<typename T>
+        Linked<T, true>::operator T() const {
+            return load();
+        }
+
+        template<typename T>
+        void Linked<T, true>::store(T const& a_tValue) {
+            m_value.store(a_tValue);
+        }
+
+        template<typename T>
+        Linked<T, false>::Linked()
+            : m_pValue{ std::make_shared<T const>() }
+        {}
+
+        template<typename T>
+        Linked<T, false>::Linked(T const& a_tValue)
+            : m_pValue{ std::make_shared<T const>(a_tValue) }
+        {}
+
+        template<typename T>
+        T Linked<T, false>::load() const {
+            return *snapshot();
+        }
+
+        template<typename T>
+        Linked<T, false>::operator T() const {
+            return load();
+        }
+
+        template<typename T>
+        std::shared_ptr<T const> Linked<T, false>::snapshot() const {
+            return std::atomic_load(&m_pValue);
+        }
+
+        template<typename T>
+        void Linked<T, false>::store(T const& a_tValue) {
+            std::atomic_store(&m_pValue, std::make_shared<T const>(a_tValue));
+        }
+
         namespace internal {
 
+            //////////////////////////////////////////////////
+            ///// Charconv translator                    /////
+            //////////////////////////////////////////////////
+
+            template<typename T, typename = void>
+            struct has_stream_extraction : std::false_type {};
+            template<typename T>
+            struct has_stream_extraction<T, std::void_t<decltype(std::declval<std::istream&>() >> std::declval<T&>())>> : std::true_type {};
+
+            template<typename T>
+            constexpr bool is_character_v{
+                std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+                std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t> };
+
+            /**
+             * @brief Tell if a type is converted by TCharconvTranslator rather than by the boost stream translator
+             * @details Characters keep their textual representation, floating points need the C++17 floating point charconv
+             *          and enums providing their own stream extraction operator keep their representation
+             */
+            template<typename T>
+            constexpr bool is_charconv_v{
+#ifdef __cpp_lib_to_chars
+                (std::is_arithmetic_v<T> && !is_character_v<T>) ||
+#else
+                (std::is_integral_v<T> && !is_character_v<T>) ||
+#endif
+                (std::is_enum_v<T> && !has_stream_extraction<T>::value) };
+
+            template<typename T, typename = void>
+            struct is_struct : std::false_type {};
+            template<typename T>
+            struct is_struct<T, std::void_t<typename StructFields<T>::Type>> : std::true_type {};
+
+            /**
+             * @brief Tell if a type is an aggregate whose fields are declared with EMBSETTINGS_STRUCT_FIELDS
+             */
+            template<typename T>
+            constexpr bool is_struct_v{ is_struct<T>::value };
+
+            template<typename M>
+            struct member_type;
+            template<typename C, typename F>
+            struct member_type<F C::*> { using type = F; };
+            /**
+             * @brief Type of the field pointed by a pointer to member
+             */
+            template<typename M>
+            using member_type_t = typename member_type<M>::type;
+
+            /**
+             * @brief ptree translator based on std::from_chars/std::to_chars: no stream nor locale is created per value
+             * @details Floating points are written with the shortest representation reading back to the same value.
+             *          Enums are converted as their underlying type, booleans as \c true / \c false (\c 1 / \c 0 also read).
+             *          Like the stream translator, surrounding whitespaces and a leading \c + are accepted.
+             */
+            template<typename T>
+            struct TCharconvTranslator {
+                using internal_type = std::string;
+                using external_type = T;
+
+                boost::optional<T> get_value(std::string const& a_strValue) const {
+                    char const* pBegin{ a_strValue.data() };
+                    char const* pEnd{ pBegin + a_strValue.size() };
+                    while(pBegin != pEnd && std::isspace(static_cast<unsigned char>(*pBegin))) {
+                        ++pBegin;
+                    }
+                    while(pBegin != pEnd && std::isspace(static_cast<unsigned char>(*(pEnd - 1)))) {
+                        --pEnd;
+                    }
+                    if constexpr (std::is_same_v<T, bool>) {
+                        std::string_view const strValue(pBegin, static_cast<std::size_t>(pEnd - pBegin));
+                        if("true" == strValue || "1" == strValue) {
+                            return true;
+                        }
+                        if("false" == strValue || "0" == strValue) {
+                            return false;
+                        }
+                        return boost::none;
+                    }
+                    else if constexpr (std::is_enum_v<T>) {
+                        if(auto const& value = TCharconvTranslator<std::underlying_type_t<T>>{}.get_value(std::string(pBegin, pEnd))) {
+                            return static_cast<T>(*value);
+                        }
+                        return boost::none;
+                    }
+                    else {
+                        if(pBegin != pEnd && '+' == *pBegin) {
+                            ++pBegin;
+                        }
+                        T tValue{};
+                        auto const result = std::from_chars(pBegin, pEnd, tValue);
+                        if(std::errc{} != result.ec || pEnd != result.ptr || pBegin == pEnd) {
+                            return boost::none;
+                        }
+                        return tValue;
+                    }
+                }
+
+                boost::optional<std::string> put_value(T const& a_tValue) const {
+                    if constexpr (std::is_same_v<T, bool>) {
+                        return std::string{ a_tValue ? "true" : "false" };
+                    }
+                    else if constexpr (std::is_enum_v<T>) {
+                        return TCharconvTranslator<std::underlying_type_t<T>>{}.put_value(static_cast<std::underlying_type_t<T>>(a_tValue));
+                    }
+                    else {
+                        char acBuffer[64];  // Enough for the shortest representation of any floating point
+                        auto const result = std::to_chars(std::begin(acBuffer), std::end(acBuffer), a_tValue);
+                        return std::string(acBuffer, result.ptr);
+                    }
+                }
+            };
+
+            //////////////////////////////////////////////////
+            ///// Packed vectors                         /////
+            //////////////////////////////////////////////////
+
+            template<typename T>
+            constexpr bool is_packable_v{ is_charconv_v<T> && std::is_arithmetic_v<T> && !std::is_same_v<T, bool> };
+
+            /**
+             * @brief Parse values stored with VectorStorage::Packed
+             * @details The vector is reserved once, then each value is converted in place by std::from_chars.
+             *          Like in the nodes storage, a malformed value is read as {}.
+             * @param a_strPacked   Values separated by whitespaces
+             * @param a_rtvecOutput Parsed values, cleared first (its capacity is reused)
+             */
+            template<typename T>
+            void parse_packed_vector(std::string const& a_strPacked, std::vector<T> & a_rtvecOutput) {
+                static_assert(is_packable_v<T>, "VectorStorage::Packed requires an arithmetic type");
+                a_rtvecOutput.clear();
+                a_rtvecOutput.reserve(count_packed_separators(a_strPacked) + 1);
+                char const* pCurrent{ a_strPacked.data() };
+                char const* const pEnd{ pCurrent + a_strPacked.size() };
+                auto const isSpace = [](char a_c) { return std::isspace(static_cast<unsigned char>(a_c)) != 0; };
+                for(;;) {
+                    while(pCurrent != pEnd && isSpace(*pCurrent)) {
+                        ++pCurrent;
+                    }
+                    if(pCurrent == pEnd) {
+                        break;
+                    }
+                    if('+' == *pCurrent) {
+                        ++pCurrent;
+                    }
+                    T tValue{};
+                    auto const result = std::from_chars(pCurrent, pEnd, tValue);
+                    pCurrent = result.ptr;
+                    if(std::errc{} != result.ec || (pCurrent != pEnd && !isSpace(*pCurrent))) {
+                        tValue = T{};
+                        while(pCurrent != pEnd && !isSpace(*pCurrent)) {
+                            ++pCurrent;
+                        }
+                    }
+                    a_rtvecOutput.push_back(tValue);
+                }
+            }
+
+            /**
+             * @brief Parse values stored with VectorStorage::Packed
+             * @param a_strPacked   Values separated by whitespaces
+             * @return std::vector<T> Parsed values
+             */
+            template<typename T>
+            std::vector<T> parse_packed_vector(std::string const& a_strPacked) {
+                std::vector<T> vecOutput{};
+                parse_packed_vector(a_strPacked, vecOutput);
+                return vecOutput;
+            }
+
+            /**
+             * @brief Append a value to values stored with VectorStorage::Packed
+             * @param a_rstrPacked  Values separated by spaces
+             * @param a_tValue      Value to append
+             */
+            template<typename T>
+            void append_packed_value(std::string & a_rstrPacked, T const& a_tValue) {
+                static_assert(is_packable_v<T>, "VectorStorage::Packed requires an arithmetic type");
+                char acBuffer[64];  // Enough for the shortest representation of any floating point
+                auto const result = std::to_chars(std::begin(acBuffer), std::end(acBuffer), a_tValue);
+                if(!a_rstrPacked.empty()) {
+                    a_rstrPacked.push_back(' ');
+                }
+                a_rstrPacked.append(acBuffer, result.ptr);
+            }
+
+            /**
+             * @brief Format values to store them with VectorStorage::Packed
+             * @param a_tvecValues  Values to format
+             * @return std::string  Values separated by spaces
+             */
+            template<typename T>
+            std::string format_packed_vector(std::vector<T> const& a_tvecValues) {
+                std::string strPacked{};
+                strPacked.reserve(a_tvecValues.size() * (std::is_floating_point_v<T> ? 24 : 12));
+                for(auto const& tValue : a_tvecValues) {
+                    append_packed_value(strPacked, tValue);
+                }
+                return strPacked;
+            }
+
+            /**
+             * @brief Read the values of a vector setting element stored with VectorStorage::Sidecar
+             * @param a_strFileName     Name of the settings file
+             * @param a_strElementName  Name of the setting element
+             * @param a_tvecDefault     Value returned if the sidecar does not exist
+             * @param a_bWriterView     Also see the values written by the pending transaction
+             * @return std::vector<T>   Copy of the values
+             */
+            template<typename T>
+            std::vector<T> sidecar_vector(std::string const& a_strFileName, std::string const& a_strElementName, std::vector<T> const& a_tvecDefault, bool a_bWriterView = false) {
+                static_assert(std::is_arithmetic_v<T>, "VectorStorage::Sidecar requires an arithmetic type");
+                if(auto const& pContent = read_sidecar(a_strFileName, a_strElementName, sizeof(T), a_bWriterView)) {
+                    auto const* ptData = static_cast<T const*>(pContent->pData);
+                    return std::vector<T>(ptData, ptData + pContent->uCount);
+                }
+                return a_tvecDefault;
+            }
+
             //////////////////////////////////////////////////
             ///// Default read/write methods             /////
             //////////////////////////////////////////////////
 
             template<typename T>
             T read_tree(boost::property_tree::ptree const& a_rTree, T const& tDefaultVal) {
-                return a_rTree.get<T>("", tDefaultVal);
+                if constexpr (is_struct_v<T>) {
+                    // Each field is a child of the node, the absent ones keep their default value
+                    T tVal{ tDefaultVal };
+                    StructFields<T>::for_each([&](char const* a_szField, auto a_pField) {
+                        if (auto it = a_rTree.find(a_szField); it != a_rTree.not_found()) {
+                            tVal.*a_pField = read_tree(it->second, tDefaultVal.*a_pField);
+                        }
+                    });
+                    return tVal;
+                }
+                else if constexpr (is_charconv_v<T>) {
+                    return a_rTree.get_value(tDefaultVal, TCharconvTranslator<T>{});
+                }
+                else {
+                    return a_rTree.get<T>("", tDefaultVal);
+                }
+            }
+
+            /**
+             * @brief Read a value seen through a ReadGuard: strings are borrowed from the node
+             * @param a_rTree   Node of the value
+             * @return ViewType<T> Value of the node
+             */
+            template<typename T>
+            ViewType<T> view_tree(boost::property_tree::ptree const& a_rTree) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return a_rTree.data();
+                }
+                else {
+                    return read_tree(a_rTree, T{});
+                }
             }
 
             template<typename T>
             void write_tree(boost::property_tree::ptree & a_rTree, T const& tVal) {
-                a_rTree.put<T>("", tVal);
+                if constexpr (is_struct_v<T>) {
+                    // Each field is written in a child of the node, created in place
+                    a_rTree.clear();
+                    StructFields<T>::for_each([&](char const* a_szField, auto a_pField) {
+                        a_rTree.push_back(boost::property_tree::ptree::value_type{ a_szField, boost::property_tree::ptree{} });
+                        write_tree(a_rTree.back().second, tVal.*a_pField);
+                    });
+                }
+                else if constexpr (is_charconv_v<T>) {
+                    a_rTree.put_value(tVal, TCharconvTranslator<T>{});
+                }
+                else {
+                    a_rTree.put<T>("", tVal);
+                }
+            }
+
+            /**
+             * @brief Compare two values of a setting element, field by field for the aggregates declared with EMBSETTINGS_STRUCT_FIELDS
+             */
+            template<typename T>
+            bool values_equal(T const& a_tLeft, T const& a_tRight) {
+                if constexpr (is_struct_v<T>) {
+                    bool bEqual{ true };
+                    StructFields<T>::for_each([&](char const*, auto a_pField) {
+                        bEqual = bEqual && values_equal(a_tLeft.*a_pField, a_tRight.*a_pField);
+                    });
+                    return bEqual;
+                }
+                else {
+                    return a_tLeft == a_tRight;
+                }
+            }
+
+            /**
+             * @brief Write a value in a node, moving it if it is an rvalue string
+             * @tparam T        Type of the value
+             * @param a_rTree   Node of the value
+             * @param a_tVal    Value to write
+             */
+            template<typename T, typename Value>
+            void forward_tree(boost::property_tree::ptree & a_rTree, Value && a_tVal) {
+                if constexpr (std::is_same_v<T, std::string> && !std::is_reference_v<Value>) {
+                    a_rTree.data() = std::move(a_tVal);
+                }
+                else {
+                    write_tree<T>(a_rTree, a_tVal);
+                }
+            }
+
+            /**
+             * @brief Build once the tree of the default value of a vector or map setting element, seen by views when absent from the file
+             * @tparam Element  Vector or map setting element
+             * @return boost::property_tree::ptree const& Children of the default value
+             */
+            template<typename Element>
+            boost::property_tree::ptree const& default_children_tree() {
+                static boost::property_tree::ptree const s_DefaultTree = [] {
+                    boost::property_tree::ptree defaultTree{};
+                    for (auto const& value : Element::Default) {
+                        boost::property_tree::ptree subTree{};
+                        if constexpr (std::is_same_v<typename Element::Type, std::vector<typename Element::Type::value_type>>) {
+                            write_tree(subTree, value);
+                            defaultTree.push_back(std::make_pair(std::string{}, subTree));
+                        }
+                        else {
+                            write_tree(subTree, value.second);
+                            defaultTree.push_back(std::make_pair(value.first, subTree));
+                        }
+                    }
+                    return defaultTree;
+                }();
+                return s_DefaultTree;
             }
 
             template<typename T>
             std::string stringify_type(T const& tVal) {
-                return std::to_string(tVal);
+                if constexpr (is_struct_v<T>) {
+                    boost::property_tree::ptree tree{};
+                    write_tree(tree, tVal);
+                    return stringify_tree(tree);
+                }
+                else if constexpr (is_charconv_v<T>) {
+                    return *TCharconvTranslator<T>{}.put_value(tVal);
+                }
+                else {
+                    return std::to_string(tVal);
+                }
             }
 
             inline std::string stringify_type(std::string const& tVal) {
                 return tVal;
             }
 
-            inline std::string stringify_type(bool const& tVal) {
-                return tVal ? "true" : "false";
-            }
-
+#ifndef __cpp_lib_to_chars
             inline std::string stringify_type(double const& tVal) {
                 std::ostringstream out;
                 out.precision(17);
                 out << std::noshowpoint << tVal;
                 return std::move(out).str();
             }
+#endif
 
             //////////////////////////////////////////////////
             ///// SettingElement                         /////
@@ -56,27 +505,32 @@ namespace emb {
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, true)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
-                    // Get the subtree corresponding to the key
-                    if(auto const& subTree = pTree->get_child_optional(strKey)) {
-                        tResult = read_tree(*subTree, a_tDefault);
-                    }
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
+                    // Read the subtree corresponding to the key
+                    tResult = value_from_tree(*pTree, strKey, a_tDefault);
+                }
+                if(has_monitoring_callback()) {
+                    auto const [strFileName, strElementName] = get_element_names(a_strFile, a_strElement);
+                    call_monitoring_callback(emb::settings::MonitoringInformation{
+                        emb::settings::MonitoringOperation::Read,
+                        strFileName, strElementName,
+                        stringify_type(tResult)
+                    });
                 }
-                call_monitoring_callback(emb::settings::MonitoringInformation{
-                    emb::settings::MonitoringOperation::Read,
-                    a_strFile, a_strElement,
-                    stringify_type(tResult)
-                });
                 return tResult;
             }
 
-            template<typename Type>
-            void SettingElement::write_setting(std::string const& a_strFile, std::string const& a_strElement, Type const& a_tNew, bool a_bMonitor) {
+            template<typename Type, typename Value>
+            void SettingElement::write_setting(std::string const& a_strFile, std::string const& a_strElement, Value && a_tNew, bool a_bMonitor) {
+                static_assert(std::is_same_v<std::decay_t<Value>, Type>, "write_setting requires a value of the setting type");
+                // The value is stringified before being moved into the tree
+                bool const bMonitor{ a_bMonitor && has_monitoring_callback() };
+                std::string const strMonitoredValue{ bMonitor ? stringify_type(a_tNew) : std::string{} };
                 // Request the boost::property_tree containing the current setting element
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, false)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
                     // There is a bug if a parameter is written with an empty value (at least in JSON, may happen also in other types)
                     // so we need to remove the key first, to avoid to see '"key": ""' texts multiply in the settings file
                     remove_tree(*pTree, strKey);
@@ -84,17 +538,20 @@ namespace emb {
                     boost::property_tree::ptree subTree{};
                     auto& rSubTree = pTree->get_child(strKey, subTree);
                     // Write the subtree
-                    write_tree(rSubTree, a_tNew);
+                    forward_tree<Type>(rSubTree, std::forward<Value>(a_tNew));
                     // If it is a new subtree, it needs to be written in the main tree
-                    if(rSubTree == subTree) {
-                        pTree->add_child(strKey, subTree);
+                    if(&rSubTree == &subTree) {
+                        pTree->add_child(strKey, boost::property_tree::ptree{}).swap(subTree);
                     }
+                    // Refresh the variables linked in AutoRefresh mode
+                    push_linked(pTree, a_strElement);
                 }
-                if(a_bMonitor) {
+                if(bMonitor) {
+                    auto const [strFileName, strElementName] = get_element_names(a_strFile, a_strElement);
                     call_monitoring_callback(emb::settings::MonitoringInformation{
                         emb::settings::MonitoringOperation::Write,
-                        a_strFile, a_strElement,
-                        stringify_type(a_tNew)
+                        strFileName, strElementName,
+                        strMonitoredValue
                     });
                 }
             }
@@ -108,17 +565,22 @@ namespace emb {
                     if (auto const& pTree = get_tree(Element::File::Name, Element::Name, false)) {
                         // Remove the element from the tree
                         remove_tree(*pTree, Element::Key);
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, Element::Name);
                     }
                     break;
                 case DefaultMode::DefaultValueWrittenInFile:
                     write_setting<typename Element::Type>(Element::File::Name, Element::Name, Element::Default, false);
                     break;
                 }
-                call_monitoring_callback(emb::settings::MonitoringInformation{
-                    emb::settings::MonitoringOperation::Reset,
-                    Element::File::Name, Element::Name,
-                    stringify_type(Element::Default)
-                });
+                if(has_monitoring_callback()) {
+                    auto const [strFileName, strElementName] = get_element_names(Element::File::Name, Element::Name);
+                    call_monitoring_callback(emb::settings::MonitoringInformation{
+                        emb::settings::MonitoringOperation::Reset,
+                        strFileName, strElementName,
+                        stringify_type(Element::Default)
+                    });
+                }
             }
 
             template<typename Element>
@@ -129,22 +591,119 @@ namespace emb {
                     // Request the boost::property_tree containing the current setting element
                     // The given tree is automatically locked & read on request and written & unlocked on deletion
                     if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
-                        try {
-                            (void)pTree->get_child(Element::Key);
-                        }
-                        catch(boost::property_tree::ptree_bad_path&) {
-                            // get_child() may throw if the key does not exist
-                            bRes = true;
-                        }
+                        bRes = !pTree->get_child_optional(Element::Key);
                     }
                     break;
                 case DefaultMode::DefaultValueWrittenInFile:
-                    bRes = Element::Default == read_setting<typename Element::Type>(Element::File::Name, Element::Name, Element::Default);
+                    bRes = values_equal(Element::Default, read_setting<typename Element::Type>(Element::File::Name, Element::Name, Element::Default));
                     break;
                 }
                 return bRes;
             }
 
+            template<typename Type>
+            void SettingElement::subscribe_setting(std::string const& a_strFile, std::string const& a_strElement, Type (*a_funcDecode)(boost::property_tree::ptree const&), change_clbk_t<Type> const& a_funcCallback) {
+                if(auto const& pElm = get_element(a_strFile, a_strElement)) {
+                    pElm->subscribe_m([a_funcDecode, a_funcCallback](boost::property_tree::ptree const& a_OldTree, boost::property_tree::ptree const& a_NewTree) {
+                        Type const tOld{ a_funcDecode(a_OldTree) };
+                        Type const tNew{ a_funcDecode(a_NewTree) };
+                        // The changes are tracked per subtree: the value itself may be unchanged
+                        if(!values_equal(tOld, tNew)) {
+                            a_funcCallback(tOld, tNew);
+                        }
+                    });
+                }
+            }
+
+            template<typename Type>
+            void SettingElement::subscribe_sidecar_setting(std::string const& a_strFile, std::string const& a_strElement, std::vector<Type> const& a_tvecDefault, change_clbk_t<std::vector<Type>> const& a_funcCallback) {
+                if(auto const& pElm = get_element(a_strFile, a_strElement)) {
+                    // Content seen by the previous call, kept mapped until the next change
+                    auto ppLast = std::make_shared<std::shared_ptr<SidecarContent const>>();
+                    auto const funcSubscriber = [a_strFile, a_strElement, a_tvecDefault, a_funcCallback, ppLast] {
+                        auto pNew = read_sidecar(a_strFile, a_strElement, sizeof(Type));
+                        if(pNew == *ppLast) {
+                            return;
+                        }
+                        auto const values = [&a_tvecDefault](std::shared_ptr<SidecarContent const> const& a_pContent) {
+                            if(!a_pContent) {
+                                return a_tvecDefault;
+                            }
+                            auto const* ptData = static_cast<Type const*>(a_pContent->pData);
+                            return std::vector<Type>(ptData, ptData + a_pContent->uCount);
+                        };
+                        std::vector<Type> const tvecOld{ values(*ppLast) };
+                        std::vector<Type> const tvecNew{ values(pNew) };
+                        *ppLast = std::move(pNew);
+                        if(!values_equal(tvecOld, tvecNew)) {
+                            a_funcCallback(tvecOld, tvecNew);
+                        }
+                    };
+                    // The file stays locked between the reading of the current content and the subscription
+                    if(auto const& pTree = get_tree(a_strFile, a_strElement, true)) {
+                        *ppLast = read_sidecar(a_strFile, a_strElement, sizeof(Type));
+                        pElm->subscribe_sidecar_m(funcSubscriber);
+                    }
+                }
+            }
+
+            template<typename Type, typename Variable>
+            void SettingElement::link_setting_pushed(std::string const& a_strFile, std::string const& a_strElement, Type (*a_funcDecode)(boost::property_tree::ptree const&), Variable& a_rVariable) {
+                if(auto const& pElm = get_element(a_strFile, a_strElement)) {
+                    pElm->link_pushed_m([a_funcDecode, &a_rVariable](boost::property_tree::ptree const& a_Tree) {
+                        if constexpr (std::is_same_v<Variable, Type>) {
+                            a_rVariable = a_funcDecode(a_Tree);
+                        }
+                        else {
+                            a_rVariable.store(a_funcDecode(a_Tree));
+                        }
+                    });
+                }
+            }
+
+            template<typename Type>
+            Type SettingElement::value_from_tree(boost::property_tree::ptree const& a_Tree, std::string const& a_strKey, Type const& a_tDefault) {
+                // Get the subtree corresponding to the key
+                if(auto const& subTree = a_Tree.get_child_optional(a_strKey)) {
+                    return read_tree(*subTree, a_tDefault);
+                }
+                return a_tDefault;
+            }
+
+            template<typename Type, VectorStorage _Storage>
+            std::vector<Type> SettingElement::vector_from_tree(boost::property_tree::ptree const& a_Tree, std::string const& a_strKey, std::vector<Type> const& a_tvecDefault) {
+                // Get each the subtree corresponding to the key
+                auto const& keyTree = a_Tree.get_child_optional(a_strKey);
+                if(!keyTree) {
+                    return a_tvecDefault;
+                }
+                if constexpr (VectorStorage::Packed == _Storage) {
+                    return parse_packed_vector<Type>(keyTree->data());
+                }
+                std::vector<Type> vecOutput{};
+                vecOutput.reserve(keyTree->size());
+                for(auto const& subTree : *keyTree) {
+                    // Read subTree content and add it to the vector
+                    vecOutput.push_back(read_tree(subTree.second, Type{}));
+                }
+                return vecOutput;
+            }
+
+            template<typename Type>
+            std::map<std::string, Type> SettingElement::map_from_tree(boost::property_tree::ptree const& a_Tree, std::string const& a_strKey, std::map<std::string, Type> const& a_tmapDefault) {
+                // Get each the subtree corresponding to the key
+                auto const& keyTree = a_Tree.get_child_optional(a_strKey);
+                if(!keyTree) {
+                    return a_tmapDefault;
+                }
+                std::map<std::string, Type> mapOutput{};
+                for(auto const& subTree : *keyTree) {
+                    // Read subTree content and add it to the map
+                    mapOutput[subTree.first] = read_tree(subTree.second, Type{});
+                }
+                return mapOutput;
+            }
+
             template<typename Type, typename Element>
             void SettingElement::link_setting(std::string const& a_strFile, std::string const& a_strElement, Type& a_rtVariable) {
                 if(auto const& pElm = get_element(a_strFile, a_strElement)) {
@@ -155,81 +714,106 @@ namespace emb {
                 }
             }
 
-            template<typename Type>
+            template<typename Type, VectorStorage _Storage>
             std::vector<Type> SettingElement::read_setting_vector(std::string const& a_strFile, std::string const& a_strElement, std::vector<Type> const& a_tvecDefault) {
+                if constexpr (VectorStorage::Sidecar == _Storage) {
+                    return sidecar_vector<Type>(a_strFile, a_strElement, a_tvecDefault);
+                }
                 std::vector<Type> vecOutput{};
                 // Request the boost::property_tree containing the current setting element
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, true)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
-                    // Get each the subtree corresponding to the key
-                    try {
-                        for(auto const& subTree : pTree->get_child(strKey)) {
-                            // Read subTree content and add it to the vector
-                            vecOutput.push_back(read_tree(subTree.second, Type{}));
-                        }
-                    }
-                    catch(boost::property_tree::ptree_bad_path&) {
-                        // get_child() may throw if the key does not exist
-                        vecOutput = a_tvecDefault;
-                    }
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
+                    // Read each the subtree corresponding to the key
+                    vecOutput = vector_from_tree<Type, _Storage>(*pTree, strKey, a_tvecDefault);
                 }
                 return vecOutput;
             }
 
-            template<typename Type>
-            void SettingElement::write_setting_vector(std::string const& a_strFile, std::string const& a_strElement, std::vector<Type> const& a_tvecNew) {
+            template<typename Type, VectorStorage _Storage, typename Values>
+            void SettingElement::write_setting_vector(std::string const& a_strFile, std::string const& a_strElement, Values && a_tvecNew) {
+                static_assert(std::is_same_v<std::decay_t<Values>, std::vector<Type>>, "write_setting_vector requires a vector of the setting type");
                 // Request the boost::property_tree containing the current setting element
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, false)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
+                    if constexpr (VectorStorage::Packed == _Storage) {
+                        // A single node, whatever the file type
+                        pTree->put(strKey, format_packed_vector(a_tvecNew));
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, a_strElement);
+                        return;
+                    }
+                    if constexpr (VectorStorage::Sidecar == _Storage) {
+                        // The settings file is only written the first time, to reference the sidecar
+                        pTree->put(strKey, sidecar_file_name(a_strFile, a_strElement));
+                        write_sidecar(a_strFile, a_strElement, a_tvecNew.data(), sizeof(Type), a_tvecNew.size());
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, a_strElement);
+                        return;
+                    }
                     // Get the file type to customize data representation
-                    auto eType = emb::settings::get_file(a_strFile)->get_type_m();
+                    auto eType = get_file_type(a_strFile);
                     // Remove old subtree
                     remove_tree(*pTree, strKey);
                     // Create and add the subtree accordingly to the file type
+                    // The children are created in place in the main tree, then written: values are never copied between trees
                     switch(eType) {
                     case FileType::XML:
-                        for(auto const& value : a_tvecNew) {
-                            // Create a new subtree
-                            boost::property_tree::ptree subTree{};
-                            // Write the subtree
-                            write_tree(subTree, value);
-                            // Write the subtree into the main tree
-                            pTree->add_child(strKey + "." + internal::xml_vector_element_name(), subTree);
-                        }
-                        break;
-                    case FileType::JSON: {
-                            boost::property_tree::ptree children;
-                            for(auto const& value : a_tvecNew) {
-                                // Create a new subtree
-                                boost::property_tree::ptree subTree{};
-                                // Write the subtree
-                                write_tree(subTree, value);
-                                // Write the subtree into the main tree
-                                children.push_back(std::make_pair("", subTree));
+                    case FileType::JSON:
+                        // An empty vector has no node in XML
+                        if(FileType::JSON == eType || !a_tvecNew.empty()) {
+                            std::string const strChildKey{ FileType::XML == eType ? internal::xml_vector_element_name() : std::string{} };
+                            auto & rChildren = pTree->add_child(strKey, boost::property_tree::ptree{});
+                            for(std::size_t uIndex = 0; uIndex < a_tvecNew.size(); ++uIndex) {
+                                rChildren.push_back(boost::property_tree::ptree::value_type{ strChildKey, boost::property_tree::ptree{} });
+                                if constexpr (std::is_reference_v<Values>) {
+                                    write_tree<Type>(rChildren.back().second, a_tvecNew[uIndex]);
+                                }
+                                else {
+                                    forward_tree<Type>(rChildren.back().second, std::move(a_tvecNew[uIndex]));
+                                }
                             }
-                            pTree->add_child(strKey, children);
                         }
                         break;
                     case FileType::INI:
                         /// @todo
                         break;
                     }
+                    // Refresh the variables linked in AutoRefresh mode
+                    push_linked(pTree, a_strElement);
                 }
             }
 
-            template<typename Type>
+            template<typename Type, VectorStorage _Storage>
             void SettingElement::add_setting_vector(std::string const& a_strFile, std::string const& a_strElement, Type const& a_tNew) {
                 // Request the boost::property_tree containing the current setting element
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, false)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
+                    if constexpr (VectorStorage::Packed == _Storage) {
+                        // Append the value to the text of the node
+                        auto keyTree = pTree->get_child_optional(strKey);
+                        append_packed_value((keyTree ? *keyTree : pTree->put(strKey, std::string{})).data(), a_tNew);
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, a_strElement);
+                        return;
+                    }
+                    if constexpr (VectorStorage::Sidecar == _Storage) {
+                        // The whole sidecar is rewritten
+                        auto vecValues = sidecar_vector<Type>(a_strFile, a_strElement, {}, true);
+                        vecValues.push_back(a_tNew);
+                        pTree->put(strKey, sidecar_file_name(a_strFile, a_strElement));
+                        write_sidecar(a_strFile, a_strElement, vecValues.data(), sizeof(Type), vecValues.size());
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, a_strElement);
+                        return;
+                    }
                     // Get the file type to customize data representation
-                    auto eType = emb::settings::get_file(a_strFile)->get_type_m();
+                    auto eType = get_file_type(a_strFile);
                     // Create and add the subtree accordingly to the file type
                     switch(eType) {
                     case FileType::XML: {
@@ -246,13 +830,20 @@ namespace emb {
                             boost::property_tree::ptree subTree;
                             // Write the subtree
                             write_tree(subTree, a_tNew);
-                            // Write the subtree into the main tree
-                            pTree->get_child(strKey).push_back(std::make_pair("", subTree));
+                            // Write the subtree into the main tree, creating the array if it does not exist yet
+                            if(auto const& keyTree = pTree->get_child_optional(strKey)) {
+                                keyTree->push_back(std::make_pair("", subTree));
+                            }
+                            else {
+                                pTree->add_child(strKey, boost::property_tree::ptree{}).push_back(std::make_pair("", subTree));
+                            }
                         }
                         break;
                     case FileType::INI:
                         break;
                     }
+                    // Refresh the variables linked in AutoRefresh mode
+                    push_linked(pTree, a_strElement);
                 }
             }
 
@@ -265,10 +856,15 @@ namespace emb {
                     if (auto const& pTree = get_tree(Element::File::Name, Element::Name, false)) {
                         // Remove the element from the tree
                         remove_tree(*pTree, Element::Key);
+                        if constexpr (VectorStorage::Sidecar == Element::Storage) {
+                            remove_sidecar(Element::File::Name, Element::Name);
+                        }
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, Element::Name);
                     }
                     break;
                 case DefaultMode::DefaultValueWrittenInFile:
-                    write_setting_vector<typename Element::Type::value_type>(Element::File::Name, Element::Name, Element::Default);
+                    write_setting_vector<typename Element::Type::value_type, Element::Storage>(Element::File::Name, Element::Name, Element::Default);
                     break;
                 }
             }
@@ -281,22 +877,164 @@ namespace emb {
                     // Request the boost::property_tree containing the current setting element
                     // The given tree is automatically locked & read on request and written & unlocked on deletion
                     if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
-                        try {
-                            (void)pTree->get_child(Element::Key);
-                        }
-                        catch (boost::property_tree::ptree_bad_path&) {
-                            // get_child() may throw if the key does not exist
-                            bRes = true;
-                        }
+                        bRes = !pTree->get_child_optional(Element::Key);
                     }
                     break;
                 case DefaultMode::DefaultValueWrittenInFile:
-                    bRes = Element::Default == read_setting_vector<typename Element::Type::value_type>(Element::File::Name, Element::Name, Element::Default);
+                    bRes = Element::Default == read_setting_vector<typename Element::Type::value_type, Element::Storage>(Element::File::Name, Element::Name, Element::Default);
                     break;
                 }
                 return bRes;
             }
 
+            template<typename Element>
+            std::size_t SettingElement::size_setting_vector() {
+                if constexpr (VectorStorage::Nodes == Element::Storage) {
+                    std::size_t uSize{ Element::Default.size() };
+                    // Request the boost::property_tree containing the current setting element
+                    // The given tree is automatically locked & read on request and unlocked on deletion
+                    if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
+                        if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                            uSize = keyTree->size();
+                        }
+                    }
+                    return uSize;
+                }
+                else if constexpr (VectorStorage::Sidecar == Element::Storage) {
+                    return Element::view().size();
+                }
+                else {
+                    return Element::read().size();
+                }
+            }
+
+            template<typename Element>
+            void SettingElement::read_into_setting_vector(typename Element::Type & a_rtvecOutput) {
+                using Type = typename Element::Type::value_type;
+                if constexpr (VectorStorage::Sidecar == Element::Storage) {
+                    if (auto const& pContent = read_sidecar(Element::File::Name, Element::Name, sizeof(Type))) {
+                        auto const* ptData = static_cast<Type const*>(pContent->pData);
+                        a_rtvecOutput.assign(ptData, ptData + pContent->uCount);
+                        return;
+                    }
+                }
+                else {
+                    // Request the boost::property_tree containing the current setting element
+                    // The given tree is automatically locked & read on request and unlocked on deletion
+                    if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
+                        if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                            if constexpr (VectorStorage::Packed == Element::Storage) {
+                                parse_packed_vector(keyTree->data(), a_rtvecOutput);
+                            }
+                            else {
+                                a_rtvecOutput.resize(keyTree->size());
+                                std::size_t uIndex{ 0 };
+                                for (auto const& subTree : *keyTree) {
+                                    if constexpr (std::is_same_v<Type, std::string>) {
+                                        a_rtvecOutput[uIndex++].assign(subTree.second.data());
+                                    }
+                                    else {
+                                        a_rtvecOutput[uIndex++] = read_tree(subTree.second, Type{});
+                                    }
+                                }
+                            }
+                            return;
+                        }
+                    }
+                }
+                a_rtvecOutput = Element::Default;
+            }
+
+            template<typename Element>
+            std::optional<typename Element::Type::value_type> SettingElement::at_setting_vector(std::size_t a_uIndex) {
+                using Type = typename Element::Type::value_type;
+                if constexpr (VectorStorage::Nodes == Element::Storage) {
+                    // Request the boost::property_tree containing the current setting element
+                    // The given tree is automatically locked & read on request and unlocked on deletion
+                    if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
+                        if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                            if (a_uIndex < keyTree->size()) {
+                                return read_tree(std::next(keyTree->begin(), static_cast<std::ptrdiff_t>(a_uIndex))->second, Type{});
+                            }
+                            return std::nullopt;
+                        }
+                    }
+                    if (a_uIndex < Element::Default.size()) {
+                        return Element::Default[a_uIndex];
+                    }
+                    return std::nullopt;
+                }
+                else {
+                    auto const values = [] {
+                        if constexpr (VectorStorage::Sidecar == Element::Storage) {
+                            return Element::view();
+                        }
+                        else {
+                            return Element::read();
+                        }
+                    }();
+                    if (a_uIndex < values.size()) {
+                        return values[a_uIndex];
+                    }
+                    return std::nullopt;
+                }
+            }
+
+            template<typename Element, typename FuncNodes, typename FuncValues>
+            bool SettingElement::modify_setting_vector(FuncNodes && a_funcNodes, FuncValues && a_funcValues) {
+                using Type = typename Element::Type::value_type;
+                bool bRes{ false };
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and written & unlocked on deletion
+                if (auto const& pTree = get_tree(Element::File::Name, Element::Name, false)) {
+                    if constexpr (VectorStorage::Nodes == Element::Storage) {
+                        // Get the file type to customize data representation
+                        auto eType = get_file_type(Element::File::Name);
+                        if (FileType::INI == eType) {
+                            /// @todo vectors are not written in INI files yet
+                            return false;
+                        }
+                        std::string const strChildKey{ FileType::XML == eType ? internal::xml_vector_element_name() : std::string{} };
+                        if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                            bRes = a_funcNodes(*keyTree, strChildKey);
+                        }
+                        else {
+                            // The vector has its default value: it is written in the file only if the modification succeeds
+                            boost::property_tree::ptree defaultTree{};
+                            for (auto const& value : Element::Default) {
+                                boost::property_tree::ptree subTree{};
+                                write_tree(subTree, value);
+                                defaultTree.push_back(std::make_pair(strChildKey, subTree));
+                            }
+                            bRes = a_funcNodes(defaultTree, strChildKey);
+                            if (bRes) {
+                                pTree->add_child(Element::Key, defaultTree);
+                            }
+                        }
+                        if (bRes) {
+                            // Refresh the variables linked in AutoRefresh mode
+                            push_linked(pTree, Element::Name);
+                        }
+                    }
+                    else {
+                        // The values written by a pending transaction must be modified, not the ones seen by the readers
+                        std::vector<Type> vecValues{};
+                        if constexpr (VectorStorage::Sidecar == Element::Storage) {
+                            vecValues = sidecar_vector<Type>(Element::File::Name, Element::Name, Element::Default, true);
+                        }
+                        else {
+                            vecValues = vector_from_tree<Type, Element::Storage>(*pTree, Element::Key, Element::Default);
+                        }
+                        bRes = a_funcValues(vecValues);
+                        if (bRes) {
+                            // Also refreshes the variables linked in AutoRefresh mode
+                            write_setting_vector<Type, Element::Storage>(Element::File::Name, Element::Name, std::move(vecValues));
+                        }
+                    }
+                }
+                return bRes;
+            }
+
             template<typename Type>
             std::map<std::string, Type> SettingElement::read_setting_map(std::string const& a_strFile, std::string const& a_strElement, std::map<std::string, Type> const& a_tmapDefault) {
                 std::map<std::string, Type> mapOutput{};
@@ -304,50 +1042,49 @@ namespace emb {
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, true)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
-                    // Get each the subtree corresponding to the key
-                    try {
-                        for(auto const& subTree : pTree->get_child(strKey)) {
-                            // Read subTree content and add it to the map
-                            mapOutput[subTree.first] = read_tree(subTree.second, Type{});
-                        }
-                    }
-                    catch(boost::property_tree::ptree_bad_path&) {
-                        // get_child() may throw if the key does not exist
-                        mapOutput = a_tmapDefault;
-                    }
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
+                    // Read each the subtree corresponding to the key
+                    mapOutput = map_from_tree(*pTree, strKey, a_tmapDefault);
                 }
                 return mapOutput;
             }
 
-            template<typename Type>
-            void SettingElement::write_setting_map(std::string const& a_strFile, std::string const& a_strElement, std::map<std::string, Type> const& a_tmapNew) {
+            template<typename Type, typename Values>
+            void SettingElement::write_setting_map(std::string const& a_strFile, std::string const& a_strElement, Values && a_tmapNew) {
+                static_assert(std::is_same_v<std::decay_t<Values>, std::map<std::string, Type>>, "write_setting_map requires a map of the setting type");
                 // Request the boost::property_tree containing the current setting element
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, false)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
                     // Get the file type to customize data representation
-                    auto eType = emb::settings::get_file(a_strFile)->get_type_m();
+                    auto eType = get_file_type(a_strFile);
                     // Remove old subtree
                     remove_tree(*pTree, strKey);
                     // Create and add the subtree accordingly to the file type
+                    // The children are created in place in the main tree, then written: values are never copied between trees
                     switch(eType) {
                     case FileType::XML:
                     case FileType::JSON:
-                        for(auto const& value : a_tmapNew) {
-                            // Create a new subtree
-                            boost::property_tree::ptree subTree{};
-                            // Write the subtree
-                            write_tree(subTree, value.second);
-                            // Write the subtree into the main tree
-                            pTree->add_child(strKey + "." + value.first, subTree);
+                        if(!a_tmapNew.empty()) {
+                            auto & rChildren = pTree->add_child(strKey, boost::property_tree::ptree{});
+                            for(auto & value : a_tmapNew) {
+                                rChildren.push_back(boost::property_tree::ptree::value_type{ value.first, boost::property_tree::ptree{} });
+                                if constexpr (std::is_reference_v<Values>) {
+                                    write_tree<Type>(rChildren.back().second, value.second);
+                                }
+                                else {
+                                    forward_tree<Type>(rChildren.back().second, std::move(value.second));
+                                }
+                            }
                         }
                         break;
                     case FileType::INI:
                         /// @todo
                         break;
                     }
+                    // Refresh the variables linked in AutoRefresh mode
+                    push_linked(pTree, a_strElement);
                 }
             }
 
@@ -357,9 +1094,9 @@ namespace emb {
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(a_strFile, a_strElement, false)) {
                     // Get the key that points to where the data is stored in the tree
-                    auto strKey = get_element(a_strFile, a_strElement)->get_key_m();
+                    std::string const strKey{ get_element_key(a_strFile, a_strElement) };
                     // Get the file type to customize data representation
-                    auto eType = emb::settings::get_file(a_strFile)->get_type_m();
+                    auto eType = get_file_type(a_strFile);
                     // Create and set the subtree accordingly to the file type
                     switch(eType) {
                     case FileType::XML:
@@ -377,6 +1114,8 @@ namespace emb {
                         /// @todo
                         break;
                     }
+                    // Refresh the variables linked in AutoRefresh mode
+                    push_linked(pTree, a_strElement);
                 }
             }
 
@@ -389,6 +1128,8 @@ namespace emb {
                     if (auto const& pTree = get_tree(Element::File::Name, Element::Name, false)) {
                         // Remove the element from the tree
                         remove_tree(*pTree, Element::Key);
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, Element::Name);
                     }
                     break;
                 case DefaultMode::DefaultValueWrittenInFile:
@@ -405,13 +1146,7 @@ namespace emb {
                     // Request the boost::property_tree containing the current setting element
                     // The given tree is automatically locked & read on request and written & unlocked on deletion
                     if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
-                        try {
-                            (void)pTree->get_child(Element::Key);
-                        }
-                        catch (boost::property_tree::ptree_bad_path&) {
-                            // get_child() may throw if the key does not exist
-                            bRes = true;
-                        }
+                        bRes = !pTree->get_child_optional(Element::Key);
                     }
                     break;
                 case DefaultMode::DefaultValueWrittenInFile:
@@ -421,6 +1156,105 @@ namespace emb {
                 return bRes;
             }
 
+            template<typename Element>
+            std::optional<typename Element::Type::mapped_type> SettingElement::get_setting_map(std::string const& a_strK) {
+                using Type = typename Element::Type::mapped_type;
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and unlocked on deletion
+                if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
+                    if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                        // Use the ordered index of the subtree instead of walking its children
+                        auto it = keyTree->find(a_strK);
+                        if (it == keyTree->not_found()) {
+                            return std::nullopt;
+                        }
+                        return read_tree(it->second, Type{});
+                    }
+                }
+                if (auto it = Element::Default.find(a_strK); it != Element::Default.end()) {
+                    return it->second;
+                }
+                return std::nullopt;
+            }
+
+            template<typename Element>
+            std::size_t SettingElement::size_setting_map() {
+                std::size_t uSize{ Element::Default.size() };
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and unlocked on deletion
+                if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
+                    if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                        uSize = keyTree->size();
+                    }
+                }
+                return uSize;
+            }
+
+            template<typename Element>
+            void SettingElement::read_into_setting_map(typename Element::Type & a_rtmapOutput) {
+                using Type = typename Element::Type::mapped_type;
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and unlocked on deletion
+                if (auto const& pTree = get_tree(Element::File::Name, Element::Name, true)) {
+                    if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                        // Remove the keys absent from the file, the nodes of the others are kept
+                        for (auto it = a_rtmapOutput.begin(); it != a_rtmapOutput.end();) {
+                            if (keyTree->find(it->first) == keyTree->not_found()) {
+                                it = a_rtmapOutput.erase(it);
+                            }
+                            else {
+                                ++it;
+                            }
+                        }
+                        for (auto const& subTree : *keyTree) {
+                            auto & rtValue = a_rtmapOutput.try_emplace(subTree.first).first->second;
+                            if constexpr (std::is_same_v<Type, std::string>) {
+                                rtValue.assign(subTree.second.data());
+                            }
+                            else {
+                                rtValue = read_tree(subTree.second, Type{});
+                            }
+                        }
+                        return;
+                    }
+                }
+                a_rtmapOutput = Element::Default;
+            }
+
+            template<typename Element>
+            bool SettingElement::erase_setting_map(std::string const& a_strK) {
+                bool bRes{ false };
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and written & unlocked on deletion
+                if (auto const& pTree = get_tree(Element::File::Name, Element::Name, false)) {
+                    if (FileType::INI == get_file_type(Element::File::Name)) {
+                        /// @todo maps are not written in INI files yet
+                        return false;
+                    }
+                    if (auto const& keyTree = pTree->get_child_optional(Element::Key)) {
+                        bRes = keyTree->erase(a_strK) > 0;
+                    }
+                    else if (Element::Default.count(a_strK) > 0) {
+                        // The map has its default value: write it without the removed key
+                        boost::property_tree::ptree defaultTree{};
+                        for (auto const& value : Element::Default) {
+                            if (value.first != a_strK) {
+                                boost::property_tree::ptree subTree{};
+                                write_tree(subTree, value.second);
+                                defaultTree.push_back(std::make_pair(value.first, subTree));
+                            }
+                        }
+                        pTree->add_child(Element::Key, defaultTree);
+                        bRes = true;
+                    }
+                    if (bRes) {
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, Element::Name);
+                    }
+                }
+                return bRes;
+            }
+
             //////////////////////////////////////////////////
             ///// TSettingScalar                         /////
             //////////////////////////////////////////////////
@@ -436,7 +1270,26 @@ namespace emb {
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
             _Type TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::read() {
-                return read_setting<_Type>(_File::Name, _NameStr, Default);
+                if constexpr (_Name::Hot) {
+                    static_assert(std::is_trivially_copyable_v<_Type>, "EMBSETTINGS_HOT_SCALAR requires a trivially copyable type");
+                    if(!s_hotMirror.bPrimed.load(std::memory_order_acquire)) {
+                        prime_hot_mirror();
+                    }
+                    return s_hotMirror.value.load();
+                }
+                else {
+                    return read_setting<_Type>(_File::Name, _NameStr, Default);
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            ViewType<_Type> TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::view(ReadGuard const& a_Guard) {
+                if (auto const* pTree = a_Guard.tree(_File::Name)) {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
+                        return view_tree<_Type>(*keyTree);
+                    }
+                }
+                return Default;
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
@@ -444,8 +1297,14 @@ namespace emb {
                 write_setting<_Type>(_File::Name, _NameStr, a_tVal);
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::write(_Type&& a_tVal) {
+                write_setting<_Type>(_File::Name, _NameStr, std::move(a_tVal));
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
             void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::reset() {
+                count_reset(_File::Name);
                 reset_setting<_Name>();
             }
 
@@ -455,8 +1314,21 @@ namespace emb {
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
-            void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(_Type& a_rtVar) {
+            void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(_Type& a_rtVar, LinkMode a_eMode) {
                 link_setting<_Type, _Name>(_File::Name, _NameStr, a_rtVar);
+                if(LinkMode::AutoRefresh == a_eMode) {
+                    link_setting_pushed<Type>(_File::Name, _NameStr, &TSettingScalar::from_tree, a_rtVar);
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(Linked<_Type>& a_rVar) {
+                link_setting_pushed<Type>(_File::Name, _NameStr, &TSettingScalar::from_tree, a_rVar);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::subscribe(change_clbk_t<Type> const& a_funcCallback) {
+                subscribe_setting<Type>(_File::Name, _NameStr, &TSettingScalar::from_tree, a_funcCallback);
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
@@ -484,15 +1356,32 @@ namespace emb {
                 return std::make_unique<_Name>();
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            typename TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Type TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::from_tree(boost::property_tree::ptree const& a_Tree) {
+                return value_from_tree<_Type>(a_Tree, _KeyStr, Default);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            void TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::prime_hot_mirror() {
+                static std::once_flag s_onceFlag{};
+                std::call_once(s_onceFlag, [] {
+                    // The mirror is refreshed now, then on each write, reset or reload
+                    link_setting_pushed<_Type>(_File::Name, _NameStr, &TSettingScalar::from_tree, s_hotMirror.value);
+                    s_hotMirror.bPrimed.store(true, std::memory_order_release);
+                });
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
             bool TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::s_bRegistered =
-                SettingElement::register_element(_File::Name, _NameStr, _Name::_create_);
+                SettingElement::register_element(_File::Name, _NameStr, _KeyStr, _Name::_create_);
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
             char const* TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Name{ _NameStr };
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
             char const* TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Key{ _KeyStr };
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
             _Type const TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Default{ _Default ? *_Default : _Type{} };
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, _Type const* _Default>
+            typename TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::HotMirror TSettingScalar<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::s_hotMirror{};
 
             //////////////////////////////////////////////////
             ///// TSettingVector                         /////
@@ -509,21 +1398,123 @@ namespace emb {
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
             std::vector<_Type> TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::read() {
-                return read_setting_vector<_Type>(_File::Name, _NameStr, Default);
+                return read_setting_vector<_Type, _Name::Storage>(_File::Name, _NameStr, Default);
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
             void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::write(std::vector<_Type> const& a_tvecVal) {
-                write_setting_vector<_Type>(_File::Name, _NameStr, a_tvecVal);
+                write_setting_vector<_Type, _Name::Storage>(_File::Name, _NameStr, a_tvecVal);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::write(std::vector<_Type>&& a_tvecVal) {
+                write_setting_vector<_Type, _Name::Storage>(_File::Name, _NameStr, std::move(a_tvecVal));
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
             void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::add(_Type const& a_tVal) {
-                add_setting_vector<_Type>(_File::Name, _NameStr, a_tVal);
+                add_setting_vector<_Type, _Name::Storage>(_File::Name, _NameStr, a_tVal);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            ArrayView<_Type> TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::view() {
+                static_assert(VectorStorage::Sidecar == _Name::Storage, "view() requires VectorStorage::Sidecar");
+                if(auto pContent = read_sidecar(_File::Name, _NameStr, sizeof(_Type))) {
+                    auto const* ptData = static_cast<_Type const*>(pContent->pData);
+                    std::size_t const uCount{ pContent->uCount };
+                    return ArrayView<_Type>{ std::move(pContent), ptData, uCount };
+                }
+                return ArrayView<_Type>{ nullptr, Default.data(), Default.size() };
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::read_into(std::vector<_Type>& a_rtvecVal) {
+                read_into_setting_vector<_Name>(a_rtvecVal);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            ChildrenView<_Type, false> TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::view(ReadGuard const& a_Guard) {
+                static_assert(VectorStorage::Nodes == _Name::Storage, "view(ReadGuard) requires VectorStorage::Nodes");
+                if (auto const* pTree = a_Guard.tree(_File::Name)) {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
+                        return ChildrenView<_Type, false>{ *keyTree };
+                    }
+                }
+                return ChildrenView<_Type, false>{ default_children_tree<_Name>() };
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            std::size_t TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::size() {
+                return size_setting_vector<_Name>();
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            std::optional<_Type> TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::at(std::size_t a_uIndex) {
+                return at_setting_vector<_Name>(a_uIndex);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            bool TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::set_at(std::size_t a_uIndex, _Type const& a_tVal) {
+                return modify_setting_vector<_Name>(
+                    [&](boost::property_tree::ptree & a_rNode, std::string const&) {
+                        if (a_uIndex >= a_rNode.size()) {
+                            return false;
+                        }
+                        write_tree(std::next(a_rNode.begin(), static_cast<std::ptrdiff_t>(a_uIndex))->second, a_tVal);
+                        return true;
+                    },
+                    [&](std::vector<_Type> & a_rtvecValues) {
+                        if (a_uIndex >= a_rtvecValues.size()) {
+                            return false;
+                        }
+                        a_rtvecValues[a_uIndex] = a_tVal;
+                        return true;
+                    });
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            bool TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::insert_at(std::size_t a_uIndex, _Type const& a_tVal) {
+                return modify_setting_vector<_Name>(
+                    [&](boost::property_tree::ptree & a_rNode, std::string const& a_strChildKey) {
+                        if (a_uIndex > a_rNode.size()) {
+                            return false;
+                        }
+                        boost::property_tree::ptree subTree{};
+                        write_tree(subTree, a_tVal);
+                        a_rNode.insert(std::next(a_rNode.begin(), static_cast<std::ptrdiff_t>(a_uIndex)), std::make_pair(a_strChildKey, subTree));
+                        return true;
+                    },
+                    [&](std::vector<_Type> & a_rtvecValues) {
+                        if (a_uIndex > a_rtvecValues.size()) {
+                            return false;
+                        }
+                        a_rtvecValues.insert(a_rtvecValues.begin() + static_cast<std::ptrdiff_t>(a_uIndex), a_tVal);
+                        return true;
+                    });
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            bool TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::erase_at(std::size_t a_uIndex) {
+                return modify_setting_vector<_Name>(
+                    [&](boost::property_tree::ptree & a_rNode, std::string const&) {
+                        if (a_uIndex >= a_rNode.size()) {
+                            return false;
+                        }
+                        a_rNode.erase(std::next(a_rNode.begin(), static_cast<std::ptrdiff_t>(a_uIndex)));
+                        return true;
+                    },
+                    [&](std::vector<_Type> & a_rtvecValues) {
+                        if (a_uIndex >= a_rtvecValues.size()) {
+                            return false;
+                        }
+                        a_rtvecValues.erase(a_rtvecValues.begin() + static_cast<std::ptrdiff_t>(a_uIndex));
+                        return true;
+                    });
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
             void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::reset() {
+                count_reset(_File::Name);
                 reset_setting_vector<_Name>();
             }
 
@@ -533,8 +1524,26 @@ namespace emb {
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
-            void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(std::vector<_Type>& a_rtvecVal) {
+            void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(std::vector<_Type>& a_rtvecVal, LinkMode a_eMode) {
                 link_setting<std::vector<_Type>, _Name>(_File::Name, _NameStr, a_rtvecVal);
+                if(LinkMode::AutoRefresh == a_eMode) {
+                    link_setting_pushed<Type>(_File::Name, _NameStr, &TSettingVector::from_tree, a_rtvecVal);
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(Linked<std::vector<_Type>>& a_rVar) {
+                link_setting_pushed<Type>(_File::Name, _NameStr, &TSettingVector::from_tree, a_rVar);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            void TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::subscribe(change_clbk_t<Type> const& a_funcCallback) {
+                if constexpr (VectorStorage::Sidecar == _Name::Storage) {
+                    subscribe_sidecar_setting<_Type>(_File::Name, _NameStr, Default, a_funcCallback);
+                }
+                else {
+                    subscribe_setting<Type>(_File::Name, _NameStr, &TSettingVector::from_tree, a_funcCallback);
+                }
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
@@ -543,19 +1552,26 @@ namespace emb {
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(_File::Name, _NameStr, true)) {
                     // Get each the subtree corresponding to the key
-                    try {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
                         boost::property_tree::ptree newTree{};
-                        for (auto const& subTree : pTree->get_child(_KeyStr)) {
-                            // Read subTree content and add it to the new tree
-                            newTree.push_back(std::make_pair("", subTree.second));
+                        if constexpr (VectorStorage::Nodes != _Name::Storage) {
+                            for (auto const& value : read()) {
+                                // Write each value in its own subtree of the new tree
+                                boost::property_tree::ptree subTree{};
+                                write_tree(subTree, value);
+                                newTree.push_back(std::make_pair("", subTree));
+                            }
+                        }
+                        else {
+                            for (auto const& subTree : *keyTree) {
+                                // Read subTree content and add it to the new tree
+                                newTree.push_back(std::make_pair("", subTree.second));
+                            }
                         }
                         boost::property_tree::ptree newRootTree{};
                         newRootTree.add_child("root", newTree);
                         return stringify_tree(newRootTree);
                     }
-                    catch (boost::property_tree::ptree_bad_path&) {
-                        // get_child() may throw if the key does not exist
-                    }
                 }
                 return "[?]";
             }
@@ -575,9 +1591,20 @@ namespace emb {
                 return std::make_unique<_Name>();
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
+            typename TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Type TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::from_tree(boost::property_tree::ptree const& a_Tree) {
+                if constexpr (VectorStorage::Sidecar == _Name::Storage) {
+                    // The tree only references the sidecar file
+                    return sidecar_vector<_Type>(_File::Name, _NameStr, Default);
+                }
+                else {
+                    return vector_from_tree<_Type, _Name::Storage>(a_Tree, _KeyStr, Default);
+                }
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
             bool TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::s_bRegistered =
-                SettingElement::register_element(_File::Name, _NameStr, _Name::_create_);
+                SettingElement::register_element(_File::Name, _NameStr, _KeyStr, _Name::_create_);
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
             char const* TSettingVector<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Name{ _NameStr };
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::vector<_Type> const* _Default>
@@ -603,18 +1630,59 @@ namespace emb {
                 return read_setting_map<_Type>(_File::Name, _NameStr, Default);
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::read_into(std::map<std::string, _Type>& a_rtmapVal) {
+                read_into_setting_map<_Name>(a_rtmapVal);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            ChildrenView<_Type, true> TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::view(ReadGuard const& a_Guard) {
+                if (auto const* pTree = a_Guard.tree(_File::Name)) {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
+                        return ChildrenView<_Type, true>{ *keyTree };
+                    }
+                }
+                return ChildrenView<_Type, true>{ default_children_tree<_Name>() };
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
             void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::write(std::map<std::string, _Type> const& a_tmapVal) {
                 write_setting_map<_Type>(_File::Name, _NameStr, a_tmapVal);
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::write(std::map<std::string, _Type>&& a_tmapVal) {
+                write_setting_map<_Type>(_File::Name, _NameStr, std::move(a_tmapVal));
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
             void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::set(std::string const& a_strKey, _Type const& a_tVal) {
                 set_setting_map<_Type>(_File::Name, _NameStr, a_strKey, a_tVal);
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            std::optional<_Type> TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::get(std::string const& a_strKey) {
+                return get_setting_map<_Name>(a_strKey);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            bool TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::contains(std::string const& a_strKey) {
+                return get_setting_map<_Name>(a_strKey).has_value();
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            bool TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::erase(std::string const& a_strKey) {
+                return erase_setting_map<_Name>(a_strKey);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            std::size_t TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::size() {
+                return size_setting_map<_Name>();
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
             void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::reset() {
+                count_reset(_File::Name);
                 reset_setting_map<_Name>();
             }
 
@@ -624,8 +1692,21 @@ namespace emb {
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
-            void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(std::map<std::string, _Type>& a_rtmapVal) {
+            void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(std::map<std::string, _Type>& a_rtmapVal, LinkMode a_eMode) {
                 link_setting<std::map<std::string, _Type>, _Name>(_File::Name, _NameStr, a_rtmapVal);
+                if(LinkMode::AutoRefresh == a_eMode) {
+                    link_setting_pushed<Type>(_File::Name, _NameStr, &TSettingMap::from_tree, a_rtmapVal);
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::link(Linked<std::map<std::string, _Type>>& a_rVar) {
+                link_setting_pushed<Type>(_File::Name, _NameStr, &TSettingMap::from_tree, a_rVar);
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            void TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::subscribe(change_clbk_t<Type> const& a_funcCallback) {
+                subscribe_setting<Type>(_File::Name, _NameStr, &TSettingMap::from_tree, a_funcCallback);
             }
 
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
@@ -634,17 +1715,14 @@ namespace emb {
                 // The given tree is automatically locked & read on request and written & unlocked on deletion
                 if (auto const& pTree = get_tree(_File::Name, _NameStr, true)) {
                     // Get each the subtree corresponding to the key
-                    try {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
                         boost::property_tree::ptree newTree{};
-                        for (auto const& subTree : pTree->get_child(_KeyStr)) {
+                        for (auto const& subTree : *keyTree) {
                             // Read subTree content and add it to the new tree
                             newTree.put_child(subTree.first, subTree.second);
                         }
                         return stringify_tree(newTree);
                     }
-                    catch (boost::property_tree::ptree_bad_path&) {
-                        // get_child() may throw if the key does not exist
-                    }
                 }
                 return "{?}";
             }
@@ -664,9 +1742,14 @@ namespace emb {
                 return std::make_unique<_Name>();
             }
 
+            template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
+            typename TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Type TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::from_tree(boost::property_tree::ptree const& a_Tree) {
+                return map_from_tree<_Type>(a_Tree, _KeyStr, Default);
+            }
+
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
             bool TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::s_bRegistered =
-                SettingElement::register_element(_File::Name, _NameStr, _Name::_create_);
+                SettingElement::register_element(_File::Name, _NameStr, _KeyStr, _Name::_create_);
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
             char const* TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Name{ _NameStr };
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
@@ -674,6 +1757,180 @@ namespace emb {
             template<typename _Name, char const* _NameStr, typename _Type, char const* _TypeStr, typename _File, char const* _KeyStr, std::map<std::string, _Type> const* _Default>
             std::map<std::string, _Type> const TSettingMap<_Name, _NameStr, _Type, _TypeStr, _File, _KeyStr, _Default>::Default{ _Default ? *_Default : std::map<std::string, _Type>{} };
 
+            //////////////////////////////////////////////////
+            ///// TSettingTable                          /////
+            //////////////////////////////////////////////////
+
+            /**
+             * @brief Write the rows of a table in the node of a table setting element, one child per row
+             * @details The rows are built column by column: each column is visited once
+             * @param a_Table       Rows to write
+             * @param a_rNode       Node of the setting element, empty
+             * @param a_strChildKey Key of the row nodes
+             */
+            template<typename TableType>
+            void table_to_tree(TableType const& a_Table, boost::property_tree::ptree & a_rNode, std::string const& a_strChildKey) {
+                using Record = std::decay_t<decltype(a_Table.row(0))>;
+                std::vector<std::string> vecRows(a_Table.size());
+                boost::property_tree::ptree cell{};
+                bool bFirstField{ true };
+                StructFields<Record>::for_each([&](char const*, auto a_pField) {
+                    auto const& values = a_Table.column(a_pField);
+                    for (std::size_t uRow = 0; uRow < vecRows.size(); ++uRow) {
+                        write_tree<member_type_t<decltype(a_pField)>>(cell, values[uRow]);
+                        if (!bFirstField) {
+                            vecRows[uRow].push_back(';');
+                        }
+                        append_table_cell(vecRows[uRow], cell.data());
+                    }
+                    bFirstField = false;
+                });
+                for (auto & strRow : vecRows) {
+                    a_rNode.push_back(boost::property_tree::ptree::value_type{ a_strChildKey, boost::property_tree::ptree{} });
+                    a_rNode.back().second.data() = std::move(strRow);
+                }
+            }
+
+            /**
+             * @brief Read the rows of a table from the node of a table setting element
+             * @details A missing field has the value {}, a row whose primary key is already present is ignored
+             * @param a_Node        Node of the setting element
+             * @param a_rTable      Rows read, appended
+             */
+            template<typename TableType>
+            void table_from_tree(boost::property_tree::ptree const& a_Node, TableType & a_rTable) {
+                using Record = std::decay_t<decltype(a_rTable.row(0))>;
+                a_rTable.reserve(a_Node.size());
+                std::vector<std::string> vecCells{};
+                boost::property_tree::ptree cell{};
+                for (auto const& rowTree : a_Node) {
+                    split_table_row(rowTree.second.data(), vecCells);
+                    Record stRow{};
+                    std::size_t uField{ 0 };
+                    StructFields<Record>::for_each([&](char const*, auto a_pField) {
+                        using Field = member_type_t<decltype(a_pField)>;
+                        if (uField < vecCells.size()) {
+                            cell.data().swap(vecCells[uField]);
+                            stRow.*a_pField = read_tree(cell, Field{});
+                        }
+                        ++uField;
+                    });
+                    a_rTable.insert(stRow);
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::TSettingTable()
+                    : SettingElement{ _NameStr, _TypeStr, _File::Name, _KeyStr }
+            {}
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::~TSettingTable() {
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            typename TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::Type TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::read() {
+                Type tableOutput{};
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and unlocked on deletion
+                if (auto const& pTree = get_tree(_File::Name, _NameStr, true)) {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
+                        table_from_tree(*keyTree, tableOutput);
+                        return tableOutput;
+                    }
+                }
+                return Default;
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            void TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::write(Type const& a_Val) {
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and written & unlocked on deletion
+                if (auto const& pTree = get_tree(_File::Name, _NameStr, false)) {
+                    // Remove old subtree
+                    remove_tree(*pTree, _KeyStr);
+                    std::string const strChildKey{ FileType::XML == _File::Type ? internal::xml_vector_element_name() : std::string{} };
+                    table_to_tree(a_Val, pTree->add_child(_KeyStr, boost::property_tree::ptree{}), strChildKey);
+                    // Refresh the variables linked in AutoRefresh mode
+                    push_linked(pTree, _NameStr);
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            void TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::reset() {
+                count_reset(_File::Name);
+                switch (default_mode()) {
+                case DefaultMode::DefaultValueIfAbsentFromFile:
+                    // Request the boost::property_tree containing the current setting element
+                    // The given tree is automatically locked & read on request and written & unlocked on deletion
+                    if (auto const& pTree = get_tree(_File::Name, _NameStr, false)) {
+                        // Remove the element from the tree
+                        remove_tree(*pTree, _KeyStr);
+                        // Refresh the variables linked in AutoRefresh mode
+                        push_linked(pTree, _NameStr);
+                    }
+                    break;
+                case DefaultMode::DefaultValueWrittenInFile:
+                    write(Default);
+                    break;
+                }
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            bool TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::is_default() {
+                bool bRes{ false };
+                switch (default_mode()) {
+                case DefaultMode::DefaultValueIfAbsentFromFile:
+                    // Request the boost::property_tree containing the current setting element
+                    // The given tree is automatically locked & read on request and unlocked on deletion
+                    if (auto const& pTree = get_tree(_File::Name, _NameStr, true)) {
+                        bRes = !pTree->get_child_optional(_KeyStr);
+                    }
+                    break;
+                case DefaultMode::DefaultValueWrittenInFile:
+                    bRes = Default == read();
+                    break;
+                }
+                return bRes;
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            std::string TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::read_str_m() const {
+                // Request the boost::property_tree containing the current setting element
+                // The given tree is automatically locked & read on request and unlocked on deletion
+                if (auto const& pTree = get_tree(_File::Name, _NameStr, true)) {
+                    if (auto const& keyTree = pTree->get_child_optional(_KeyStr)) {
+                        return stringify_tree(*keyTree);
+                    }
+                }
+                return "{?}";
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            bool TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::is_default_m() const {
+                return is_default();
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            void TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::reset_m() const {
+                reset();
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            std::unique_ptr<SettingElement> TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::_create_() {
+                return std::make_unique<_Name>();
+            }
+
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            bool TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::s_bRegistered =
+                SettingElement::register_element(_File::Name, _NameStr, _KeyStr, _Name::_create_);
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            char const* TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::Name{ _NameStr };
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            char const* TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::Key{ _KeyStr };
+            template<typename _Name, char const* _NameStr, typename _Record, char const* _TypeStr, typename _File, char const* _KeyStr, auto _KeyField>
+            typename TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::Type const TSettingTable<_Name, _NameStr, _Record, _TypeStr, _File, _KeyStr, _KeyField>::Default{};
+
             //////////////////////////////////////////////////
             ///// TSettingsFile                          /////
             //////////////////////////////////////////////////
@@ -702,6 +1959,11 @@ namespace emb {
                 abort_file_transaction(_NameStr);
             }
 
+            template<typename _Name, char const* _NameStr, emb::settings::FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
+            ReadGuard TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::view() {
+                return ReadGuard{ Name, get_file_tree(_NameStr, true) };
+            }
+
             template<typename _Name, char const* _NameStr, emb::settings::FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
             void TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::read_linked() {
                 for(auto const& elm: get_element_names_list(_NameStr)) {
@@ -746,18 +2008,273 @@ namespace emb {
             }
 
             template<typename _Name, char const* _NameStr, FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
-            bool TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::s_bRegistered = SettingsFile::register_file(_NameStr, _Name::_create_);
+            bool TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::s_bRegistered = SettingsFile::register_file(_NameStr, _Type, _Name::_create_);
             template<typename _Name, char const* _NameStr, FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
             char const* TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::Name{ _NameStr };
             template<typename _Name, char const* _NameStr, FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
             char const* TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::Path{ _PathStr };
             template<typename _Name, char const* _NameStr, FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
-            emb::settings::FileType const TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::Type{ _Type };
-            template<typename _Name, char const* _NameStr, FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
             int const TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::Version{ _Version };
             template<typename _Name, char const* _NameStr, FileType _Type, char const* _PathStr, int _Version, version_clbk_t _VersionClbk>
             version_clbk_t const TSettingsFile<_Name, _NameStr, _Type, _PathStr, _Version, _VersionClbk>::VersionClbk{ _VersionClbk };
 
         }
+
+        //////////////////////////////////////////////////
+        ///// ChildrenView                           /////
+        //////////////////////////////////////////////////
+
+        template<typename T, bool _Keyed>
+        typename ChildrenView<T, _Keyed>::value_type ChildrenView<T, _Keyed>::iterator::operator*() const {
+            if constexpr (_Keyed) {
+                return value_type{ m_it->first, internal::view_tree<T>(m_it->second) };
+            }
+            else {
+                return internal::view_tree<T>(m_it->second);
+            }
+        }
+
+        //////////////////////////////////////////////////
+        ///// Table                                  /////
+        //////////////////////////////////////////////////
+
+        template<typename Record, auto _KeyField>
+        template<typename Field>
+        struct Table<Record, _KeyField>::TColumn : Table<Record, _KeyField>::ColumnBase {
+            std::vector<ColumnValue<Field>> values{};
+            std::unique_ptr<ColumnBase> clone() const override { return std::make_unique<TColumn>(*this); }
+            void reserve(std::size_t a_uSize) override { values.reserve(a_uSize); }
+            void clear() override { values.clear(); }
+            void swap_remove(std::size_t a_uIndex) override {
+                if (a_uIndex + 1 != values.size()) {
+                    values[a_uIndex] = std::move(values.back());
+                }
+                values.pop_back();
+            }
+            bool equals(ColumnBase const& a_Other) const override { return values == static_cast<TColumn const&>(a_Other).values; }
+        };
+
+        template<typename Record, auto _KeyField>
+        Table<Record, _KeyField>::Table() {
+            StructFields<Record>::for_each([this](char const*, auto a_pField) {
+                using Field = internal::member_type_t<decltype(a_pField)>;
+                static_assert(!internal::is_struct_v<Field>, "The fields of the rows of a table must be scalars");
+                m_vecColumns.push_back(std::make_unique<TColumn<Field>>());
+            });
+        }
+
+        template<typename Record, auto _KeyField>
+        Table<Record, _KeyField>::Table(Table const& a_Other)
+            : m_mapIndex{ a_Other.m_mapIndex }
+            , m_uSize{ a_Other.m_uSize }
+        {
+            m_vecColumns.reserve(a_Other.m_vecColumns.size());
+            for (auto const& pColumn : a_Other.m_vecColumns) {
+                m_vecColumns.push_back(pColumn->clone());
+            }
+        }
+
+        template<typename Record, auto _KeyField>
+        Table<Record, _KeyField>::Table(Table && a_Other)
+            : Table{}
+        {
+            *this = std::move(a_Other);
+        }
+
+        template<typename Record, auto _KeyField>
+        Table<Record, _KeyField>& Table<Record, _KeyField>::operator=(Table && a_Other) noexcept {
+            if (this != &a_Other) {
+                m_vecColumns.swap(a_Other.m_vecColumns);
+                m_mapIndex.swap(a_Other.m_mapIndex);
+                std::swap(m_uSize, a_Other.m_uSize);
+                a_Other.clear();
+            }
+            return *this;
+        }
+
+        template<typename Record, auto _KeyField>
+        Table<Record, _KeyField>& Table<Record, _KeyField>::operator=(Table const& a_Other) {
+            if (this != &a_Other) {
+                Table copy{ a_Other };
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        template<typename Record, auto _KeyField>
+        template<typename Func>
+        void Table<Record, _KeyField>::for_each_column(Func && a_funcVisit) const {
+            std::size_t uIndex{ 0 };
+            StructFields<Record>::for_each([&](char const*, auto a_pField) {
+                using Field = internal::member_type_t<decltype(a_pField)>;
+                a_funcVisit(a_pField, static_cast<TColumn<Field>&>(*m_vecColumns[uIndex++]).values);
+            });
+        }
+
+        template<typename Record, auto _KeyField>
+        template<typename Field>
+        std::size_t Table<Record, _KeyField>::column_index(Field Record::* a_pField) const {
+            std::size_t uIndex{ 0 };
+            std::size_t uFound{ m_vecColumns.size() };
+            StructFields<Record>::for_each([&](char const*, auto a_pVisited) {
+                if constexpr (std::is_same_v<decltype(a_pVisited), Field Record::*>) {
+                    if (a_pVisited == a_pField) {
+                        uFound = uIndex;
+                    }
+                }
+                ++uIndex;
+            });
+            return uFound;
+        }
+
+        template<typename Record, auto _KeyField>
+        void Table<Record, _KeyField>::reserve(std::size_t a_uSize) {
+            for (auto const& pColumn : m_vecColumns) {
+                pColumn->reserve(a_uSize);
+            }
+            m_mapIndex.reserve(a_uSize);
+        }
+
+        template<typename Record, auto _KeyField>
+        void Table<Record, _KeyField>::clear() {
+            for (auto const& pColumn : m_vecColumns) {
+                pColumn->clear();
+            }
+            m_mapIndex.clear();
+            m_uSize = 0;
+        }
+
+        template<typename Record, auto _KeyField>
+        bool Table<Record, _KeyField>::insert(Record const& a_stRow) {
+            if (!m_mapIndex.emplace(a_stRow.*_KeyField, m_uSize).second) {
+                return false;
+            }
+            for_each_column([&](auto a_pField, auto & a_rValues) {
+                a_rValues.push_back(a_stRow.*a_pField);
+            });
+            ++m_uSize;
+            return true;
+        }
+
+        template<typename Record, auto _KeyField>
+        bool Table<Record, _KeyField>::update(Record const& a_stRow) {
+            auto it = m_mapIndex.find(a_stRow.*_KeyField);
+            if (it == m_mapIndex.end()) {
+                return false;
+            }
+            for_each_column([&](auto a_pField, auto & a_rValues) {
+                a_rValues[it->second] = a_stRow.*a_pField;
+            });
+            return true;
+        }
+
+        template<typename Record, auto _KeyField>
+        bool Table<Record, _KeyField>::erase(Key const& a_tKey) {
+            auto it = m_mapIndex.find(a_tKey);
+            if (it == m_mapIndex.end()) {
+                return false;
+            }
+            std::size_t const uIndex{ it->second };
+            m_mapIndex.erase(it);
+            for (auto const& pColumn : m_vecColumns) {
+                pColumn->swap_remove(uIndex);
+            }
+            --m_uSize;
+            // The last row moved to the position of the removed one
+            if (uIndex != m_uSize) {
+                m_mapIndex.find(static_cast<Key>(column(_KeyField)[uIndex]))->second = uIndex;
+            }
+            return true;
+        }
+
+        template<typename Record, auto _KeyField>
+        std::optional<std::size_t> Table<Record, _KeyField>::find(Key const& a_tKey) const {
+            if (auto it = m_mapIndex.find(a_tKey); it != m_mapIndex.end()) {
+                return it->second;
+            }
+            return std::nullopt;
+        }
+
+        template<typename Record, auto _KeyField>
+        std::optional<Record> Table<Record, _KeyField>::get(Key const& a_tKey) const {
+            if (auto const& uIndex = find(a_tKey)) {
+                return row(*uIndex);
+            }
+            return std::nullopt;
+        }
+
+        template<typename Record, auto _KeyField>
+        Record Table<Record, _KeyField>::row(std::size_t a_uIndex) const {
+            Record stRow{};
+            for_each_column([&](auto a_pField, auto const& a_Values) {
+                stRow.*a_pField = a_Values[a_uIndex];
+            });
+            return stRow;
+        }
+
+        template<typename Record, auto _KeyField>
+        template<typename Field>
+        std::vector<typename Table<Record, _KeyField>::template ColumnValue<Field>> const& Table<Record, _KeyField>::column(Field Record::* a_pField) const {
+            static std::vector<ColumnValue<Field>> const s_vecEmpty{};
+            std::size_t const uIndex{ column_index(a_pField) };
+            if (uIndex >= m_vecColumns.size()) {
+                return s_vecEmpty;
+            }
+            return static_cast<TColumn<Field> const&>(*m_vecColumns[uIndex]).values;
+        }
+
+        template<typename Record, auto _KeyField>
+        template<typename Field, typename Pred>
+        std::vector<std::size_t> Table<Record, _KeyField>::filter(Field Record::* a_pField, Pred a_funcPred) const {
+            auto const& values = column(a_pField);
+            // Branchless pass over the column, then gathering of the positions
+            std::vector<std::uint8_t> vecMatches(values.size());
+            for (std::size_t uIndex = 0; uIndex < values.size(); ++uIndex) {
+                vecMatches[uIndex] = a_funcPred(values[uIndex]) ? 1 : 0;
+            }
+            std::vector<std::size_t> vecRows{};
+            vecRows.reserve(static_cast<std::size_t>(std::count(vecMatches.begin(), vecMatches.end(), std::uint8_t{ 1 })));
+            for (std::size_t uIndex = 0; uIndex < vecMatches.size(); ++uIndex) {
+                if (vecMatches[uIndex]) {
+                    vecRows.push_back(uIndex);
+                }
+            }
+            return vecRows;
+        }
+
+        template<typename Record, auto _KeyField>
+        template<typename Field, typename Pred>
+        std::size_t Table<Record, _KeyField>::count_if(Field Record::* a_pField, Pred a_funcPred) const {
+            auto const& values = column(a_pField);
+            std::size_t uCount{ 0 };
+            for (std::size_t uIndex = 0; uIndex < values.size(); ++uIndex) {
+                uCount += a_funcPred(values[uIndex]) ? 1 : 0;
+            }
+            return uCount;
+        }
+
+        template<typename Record, auto _KeyField>
+        template<typename Field>
+        Field Table<Record, _KeyField>::sum(Field Record::* a_pField) const {
+            static_assert(std::is_arithmetic_v<Field> && !std::is_same_v<Field, bool>, "sum() requires an arithmetic field");
+            Field tSum{};
+            for (auto const& tValue : column(a_pField)) {
+                tSum += tValue;
+            }
+            return tSum;
+        }
+
+        template<typename Record, auto _KeyField>
+        bool Table<Record, _KeyField>::operator==(Table const& a_Other) const {
+            if (m_uSize != a_Other.m_uSize) {
+                return false;
+            }
+            for (std::size_t uIndex = 0; uIndex < m_vecColumns.size(); ++uIndex) {
+                if (!m_vecColumns[uIndex]->equals(*a_Other.m_vecColumns[uIndex])) {
+                    return false;
+                }
+            }
+            return true;
+        }
     }
 }
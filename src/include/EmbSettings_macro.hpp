@@ -145,6 +145,65 @@ class _name final : public emb::settings::internal::TSettingScalar<
     void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
 };
 
+//////////////////////////////////////////////////////////////////////
+///// INTERNAL MACROS TO DECLARE SETTING ELEMENT HOT SCALAR      /////
+//////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Declare a hot scalar setting inside a previously declared setting file
+ * @param _name     Name of the class representing the setting
+ * @param _type     Data type of the setting
+ * @param _file     Class name of the file used to save the setting
+ * @param _key      Key string representing the position of the setting in the file (using boost property_tree synthax)
+ */
+#define EMBSETTINGS_INTERNAL_HOT_SCALAR_4(_name, _type, _file, _key)                                                                        \
+namespace EmbSettings_Private { namespace _name {                                                                                           \
+    inline char NameStr[]{ #_name };                                                                                                        \
+    inline char TypeStr[]{ #_type };                                                                                                        \
+    inline char KeyStr[]{ _key };                                                                                                           \
+} }                                                                                                                                         \
+class _name final : public emb::settings::internal::TSettingScalar<                                                                         \
+        _name,                                                                                                                              \
+        EmbSettings_Private::_name::NameStr,                                                                                                \
+        _type,                                                                                                                              \
+        EmbSettings_Private::_name::TypeStr,                                                                                                \
+        _file,                                                                                                                              \
+        EmbSettings_Private::_name::KeyStr                                                                                                  \
+    > {                                                                                                                                     \
+    void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
+public:                                                                                                                                     \
+    static constexpr bool Hot{ true };                                                                                                      \
+};
+
+/**
+ * @brief Declare a hot scalar setting inside a previously declared setting file
+ * @param _name     Name of the class representing the setting
+ * @param _type     Data type of the setting
+ * @param _file     Class name of the file used to save the setting
+ * @param _key      Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param _default  Default value of the setting if not found in the file
+ */
+#define EMBSETTINGS_INTERNAL_HOT_SCALAR_5(_name, _type, _file, _key, _default)                                                              \
+namespace EmbSettings_Private { namespace _name {                                                                                           \
+    inline char NameStr[]{ #_name };                                                                                                        \
+    inline char TypeStr[]{ #_type };                                                                                                        \
+    inline char KeyStr[]{ _key };                                                                                                           \
+    inline _type Default{ _default };                                                                                                       \
+} }                                                                                                                                         \
+class _name final : public emb::settings::internal::TSettingScalar<                                                                         \
+        _name,                                                                                                                              \
+        EmbSettings_Private::_name::NameStr,                                                                                                \
+        _type,                                                                                                                              \
+        EmbSettings_Private::_name::TypeStr,                                                                                                \
+        _file,                                                                                                                              \
+        EmbSettings_Private::_name::KeyStr,                                                                                                 \
+        &EmbSettings_Private::_name::Default                                                                                                \
+    > {                                                                                                                                     \
+    void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
+public:                                                                                                                                     \
+    static constexpr bool Hot{ true };                                                                                                      \
+};
+
 //////////////////////////////////////////////////////////////////////
 ///// INTERNAL MACROS TO DECLARE SETTING ELEMENT VECTOR          /////
 //////////////////////////////////////////////////////////////////////
@@ -199,6 +258,35 @@ class _name final : public emb::settings::internal::TSettingVector<
     void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
 };
 
+/**
+ * @brief Declare a vector setting inside a previously declared setting file
+ * @param _name     Name of the class representing the setting
+ * @param _type     Base data type of the setting. The final setting's data type is std::vector<_type>
+ * @param _file     Class name of the file used to save the setting
+ * @param _key      Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param _pdefault Pointer to a default value of the setting if not found in the file (can be nullptr)
+ * @param _storage  Storage of the values in the file (amongst \c emb::settings::VectorStorage enumeration, without the scope: e.g. Packed)
+ */
+#define EMBSETTINGS_INTERNAL_VECTOR_6(_name, _type, _file, _key, _pdefault, _storage)                                                       \
+namespace EmbSettings_Private { namespace _name {                                                                                           \
+    inline char NameStr[]{ #_name };                                                                                                        \
+    inline char TypeStr[]{ "std::vector<" #_type ">" };                                                                                     \
+    inline char KeyStr[]{ _key };                                                                                                           \
+} }                                                                                                                                         \
+class _name final : public emb::settings::internal::TSettingVector<                                                                         \
+        _name,                                                                                                                              \
+        EmbSettings_Private::_name::NameStr,                                                                                                \
+        _type,                                                                                                                              \
+        EmbSettings_Private::_name::TypeStr,                                                                                                \
+        _file,                                                                                                                              \
+        EmbSettings_Private::_name::KeyStr,                                                                                                 \
+        _pdefault                                                                                                                           \
+    > {                                                                                                                                     \
+    void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
+public:                                                                                                                                     \
+    static constexpr emb::settings::VectorStorage Storage{ emb::settings::VectorStorage::_storage };                                        \
+};
+
 //////////////////////////////////////////////////////////////////////
 ///// INTERNAL MACROS TO DECLARE SETTING ELEMENT MAP             /////
 //////////////////////////////////////////////////////////////////////
@@ -252,3 +340,131 @@ class _name final : public emb::settings::internal::TSettingMap<
     > {                                                                                                                                     \
     void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
 };
+
+//////////////////////////////////////////////////////////////////////
+///// INTERNAL MACROS TO DECLARE SETTING ELEMENT STRUCT          /////
+//////////////////////////////////////////////////////////////////////
+
+// get number of fields of a struct, up to 16
+#define EMBSETTINGS_INTERNAL_FIELDS_NARG(...) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELDS_NARG_I(__VA_ARGS__,EMBSETTINGS_INTERNAL_FIELDS_RSEQ_N()))
+#define EMBSETTINGS_INTERNAL_FIELDS_NARG_I(...) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELDS_ARG_N(__VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELDS_ARG_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define EMBSETTINGS_INTERNAL_FIELDS_RSEQ_N() 16,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+
+// visit each field of a struct
+#define EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) a_funcVisit(#_field, &_type::_field);
+#define EMBSETTINGS_INTERNAL_FIELD_2(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_1(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_3(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_2(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_4(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_3(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_5(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_4(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_6(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_5(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_7(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_6(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_8(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_7(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_9(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_8(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_10(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_9(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_11(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_10(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_12(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_11(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_13(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_12(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_14(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_13(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_15(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_14(_type, __VA_ARGS__))
+#define EMBSETTINGS_INTERNAL_FIELD_16(_type, _field, ...) EMBSETTINGS_INTERNAL_FIELD_1(_type, _field) EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_FIELD_15(_type, __VA_ARGS__))
+
+/**
+ * @brief Declare the fields of an aggregate stored by struct setting elements
+ * @param _type     Aggregate type
+ * @param ...       Names of its fields (up to 16), each one stored in a child node of the same name
+ */
+#define EMBSETTINGS_INTERNAL_STRUCT_FIELDS(_type, ...)                                                                                      \
+template<> struct emb::settings::StructFields<_type> {                                                                                      \
+    using Type = _type;                                                                                                                     \
+    template<typename Func>                                                                                                                 \
+    static void for_each(Func && a_funcVisit) {                                                                                             \
+        EMBSETTINGS_INTERNAL_EXPAND(EMBSETTINGS_INTERNAL_CONCAT(EMBSETTINGS_INTERNAL_FIELD_,                                                \
+            EMBSETTINGS_INTERNAL_FIELDS_NARG(__VA_ARGS__)) (_type, __VA_ARGS__))                                                            \
+    }                                                                                                                                       \
+};
+
+/**
+ * @brief Declare a struct setting inside a previously declared setting file
+ * @param _name     Name of the class representing the setting
+ * @param _type     Aggregate type of the setting, whose fields are declared with EMBSETTINGS_STRUCT_FIELDS
+ * @param _file     Class name of the file used to save the setting
+ * @param _key      Key string representing the position of the setting in the file (using boost property_tree synthax)
+ */
+#define EMBSETTINGS_INTERNAL_STRUCT_4(_name, _type, _file, _key)                                                                            \
+namespace EmbSettings_Private { namespace _name {                                                                                           \
+    inline char NameStr[]{ #_name };                                                                                                        \
+    inline char TypeStr[]{ #_type };                                                                                                        \
+    inline char KeyStr[]{ _key };                                                                                                           \
+} }                                                                                                                                         \
+class _name final : public emb::settings::internal::TSettingScalar<                                                                         \
+        _name,                                                                                                                              \
+        EmbSettings_Private::_name::NameStr,                                                                                                \
+        _type,                                                                                                                              \
+        EmbSettings_Private::_name::TypeStr,                                                                                                \
+        _file,                                                                                                                              \
+        EmbSettings_Private::_name::KeyStr                                                                                                  \
+    > {                                                                                                                                     \
+    static_assert(emb::settings::internal::is_struct_v<_type>,                                                                              \
+        "EMBSETTINGS_STRUCT requires the fields declared with EMBSETTINGS_STRUCT_FIELDS");                                                  \
+    void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
+};
+
+/**
+ * @brief Declare a struct setting inside a previously declared setting file
+ * @param _name     Name of the class representing the setting
+ * @param _type     Aggregate type of the setting, whose fields are declared with EMBSETTINGS_STRUCT_FIELDS
+ * @param _file     Class name of the file used to save the setting
+ * @param _key      Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param _default  Default value of the setting if not found in the file
+ */
+#define EMBSETTINGS_INTERNAL_STRUCT_5(_name, _type, _file, _key, _default)                                                                  \
+namespace EmbSettings_Private { namespace _name {                                                                                           \
+    inline char NameStr[]{ #_name };                                                                                                        \
+    inline char TypeStr[]{ #_type };                                                                                                        \
+    inline char KeyStr[]{ _key };                                                                                                           \
+    inline _type Default{ _default };                                                                                                       \
+} }                                                                                                                                         \
+class _name final : public emb::settings::internal::TSettingScalar<                                                                         \
+        _name,                                                                                                                              \
+        EmbSettings_Private::_name::NameStr,                                                                                                \
+        _type,                                                                                                                              \
+        EmbSettings_Private::_name::TypeStr,                                                                                                \
+        _file,                                                                                                                              \
+        EmbSettings_Private::_name::KeyStr,                                                                                                 \
+        &EmbSettings_Private::_name::Default                                                                                                \
+    > {                                                                                                                                     \
+    static_assert(emb::settings::internal::is_struct_v<_type>,                                                                              \
+        "EMBSETTINGS_STRUCT requires the fields declared with EMBSETTINGS_STRUCT_FIELDS");                                                  \
+    void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
+};
+
+//////////////////////////////////////////////////////////////////////
+///// INTERNAL MACROS TO DECLARE SETTING ELEMENT TABLE           /////
+//////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Declare a table setting inside a previously declared setting file
+ * @param _name     Name of the class representing the setting
+ * @param _record   Aggregate type of the rows, whose fields are declared with EMBSETTINGS_STRUCT_FIELDS
+ * @param _file     Class name of the file used to save the setting
+ * @param _key      Key string representing the position of the setting in the file (using boost property_tree synthax)
+ * @param _keyfield Field of the rows used as primary key
+ */
+#define EMBSETTINGS_INTERNAL_TABLE_5(_name, _record, _file, _key, _keyfield)                                                                \
+namespace EmbSettings_Private { namespace _name {                                                                                           \
+    inline char NameStr[]{ #_name };                                                                                                        \
+    inline char TypeStr[]{ "emb::settings::Table<" #_record ">" };                                                                          \
+    inline char KeyStr[]{ _key };                                                                                                           \
+} }                                                                                                                                         \
+class _name final : public emb::settings::internal::TSettingTable<                                                                          \
+        _name,                                                                                                                              \
+        EmbSettings_Private::_name::NameStr,                                                                                                \
+        _record,                                                                                                                            \
+        EmbSettings_Private::_name::TypeStr,                                                                                                \
+        _file,                                                                                                                              \
+        EmbSettings_Private::_name::KeyStr,                                                                                                 \
+        &_record::_keyfield                                                                                                                 \
+    > {                                                                                                                                     \
+    void _register_() noexcept override { s_bRegistered = s_bRegistered; }                                                                  \
+};
@@ -1,5 +1,7 @@
 #include "../include/EmbSettings.hpp"
 #include "EmbSettings_impl.hpp"
+#include "EmbSettings_parsers.hpp"
+#include "EmbSettings_compact.hpp"
 #include <string>
 #define BOOST_BIND_GLOBAL_PLACEHOLDERS // Avoid warning
 #include <boost/property_tree/xml_parser.hpp>
@@ -8,9 +10,39 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <mutex>
 #include <map>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <deque>
+#include <unordered_set>
 #include <regex>
 #include <iostream>
+#include <thread>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
 #include "filesystem.hpp"
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define EMBSETTINGS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define EMBSETTINGS_AVX2_DISPATCH
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define EMBSETTINGS_NEON
+#include <arm_neon.h>
+#endif
 
 #if 0 // 1 to debug registering
 #define DEBUG_SELF_REGISTERING(_cmd) _cmd
@@ -18,6 +50,33 @@
 #define DEBUG_SELF_REGISTERING(_cmd)
 #endif
 
+// Only the boost writers may throw here (the parsers are isolated in EmbSettings_parsers.cpp):
+// their errors are caught when exceptions are enabled
+#ifdef __cpp_exceptions
+#define EMBSETTINGS_TRY try
+#define EMBSETTINGS_CATCH_ALL catch (...)
+#else
+#define EMBSETTINGS_TRY if (true)
+#define EMBSETTINGS_CATCH_ALL else
+#endif
+
+#if defined(BOOST_NO_EXCEPTIONS) && !defined(EMBSETTINGS_USER_THROW_EXCEPTION)
+// Without exceptions, boost requires the application to define the error handlers, which cannot return.
+// They are only reached on errors that cannot happen with the library types (e.g. a failed value translation).
+// Define EMBSETTINGS_USER_THROW_EXCEPTION (CMake option of the same name) to provide your own ones.
+namespace boost {
+    [[noreturn]] void throw_exception(std::exception const& a_Exception) {
+        std::cerr << "EmbSettings: fatal error: " << a_Exception.what() << std::endl;
+        std::abort();
+    }
+#if BOOST_VERSION >= 107300
+    [[noreturn]] void throw_exception(std::exception const& a_Exception, boost::source_location const&) {
+        throw_exception(a_Exception);
+    }
+#endif
+}
+#endif
+
 using namespace std;
 
 namespace {
@@ -33,149 +92,1356 @@ namespace {
         }
     }
 
+    /**
+     * @brief Interned strings, stored once for the program lifetime
+     */
+    struct InternTable {
+        std::mutex mutex{};
+        std::deque<std::string> deqStrings{};               ///< Stable storage
+        std::unordered_set<std::string_view> setStrings{};  ///< Views of deqStrings
+    };
+
+    InternTable& intern_table() {
+        static InternTable table{};
+        return table;
+    }
+
     string& version_element_name() {
         static string version_element_name{ "version" };
         return version_element_name;
     }
 
-    emb::settings::MonitoringCallback& monitoring_callback() {
-        static emb::settings::MonitoringCallback fctMonitoringCallback{};
-        return fctMonitoringCallback;
+    emb::settings::MonitoringCallback& monitoring_callback() {
+        static emb::settings::MonitoringCallback fctMonitoringCallback{};
+        return fctMonitoringCallback;
+    }
+
+    void watch_file(std::string_view a_strFileName, std::string const& a_strFullFileName);
+
+    std::atomic<std::size_t>& memory_budget() {
+        static std::atomic<std::size_t> uMemoryBudget{0};
+        return uMemoryBudget;
+    }
+
+    /**
+     * @brief Memory used by all the loaded settings files
+     */
+    std::atomic<std::size_t>& memory_usage() {
+        static std::atomic<std::size_t> uMemoryUsage{0};
+        return uMemoryUsage;
+    }
+
+    /**
+     * @brief Clock of the accesses to the settings files, to find the least recently used ones
+     * @details Only an order between the files is needed: it is read and advanced with relaxed atomics
+     */
+    std::atomic<std::uint64_t>& access_clock() {
+        static std::atomic<std::uint64_t> uAccessClock{1};    // Ahead of the files never accessed
+        return uAccessClock;
+    }
+
+    void enforce_memory_budget();
+
+    std::size_t string_memory_usage(std::string const& a_str) {
+        // Short strings are stored in the string object itself
+        return a_str.capacity() + 1 > sizeof(std::string) ? a_str.capacity() + 1 : 0;
+    }
+
+    /**
+     * @brief Memory used by a tree
+     */
+    struct TreeMemory {
+        std::size_t uNodesCount{0};
+        std::size_t uKeysBytes{0};      ///< Characters of the keys
+        std::size_t uValuesBytes{0};    ///< Characters of the values
+        std::size_t uBytes{0};          ///< Estimated memory used by the nodes of the children containers, the keys and the values
+    };
+
+    void measure_tree(boost::property_tree::ptree const& a_Tree, TreeMemory & a_rstMemory) {
+        a_rstMemory.uValuesBytes += a_Tree.data().size();
+        a_rstMemory.uBytes += string_memory_usage(a_Tree.data());
+        for(auto const& child : a_Tree) {
+            // Node of the multi_index container: the key/tree pair and the links of its sequenced and ordered indexes
+            ++a_rstMemory.uNodesCount;
+            a_rstMemory.uKeysBytes += child.first.size();
+            a_rstMemory.uBytes += sizeof(child) + 4 * sizeof(void*) + string_memory_usage(child.first);
+            measure_tree(child.second, a_rstMemory);
+        }
+    }
+
+    TreeMemory measure_tree(boost::property_tree::ptree const& a_Tree) {
+        TreeMemory stMemory{};
+        measure_tree(a_Tree, stMemory);
+        return stMemory;
+    }
+
+    /**
+     * @brief Performance counters of a settings file
+     */
+    enum class Counter : std::size_t { Reads, Writes, Resets, Locks, LockWaitNs, SerializeNs, BytesWritten, SkippedWrites, ParseNs, Reloads, Count };
+    enum class Histogram : std::size_t { LockWait, Serialize, DiskWrite, Count };
+
+    constexpr std::size_t s_uStatsShardsCount{ 8 };
+
+    /**
+     * @brief Shard of the performance counters, updated by a subset of the threads
+     */
+    struct alignas(64) StatsShard {
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::Count)> auCounters{};
+        std::array<std::array<std::atomic<std::uint64_t>, emb::settings::LatencyHistogram::BucketsCount>, static_cast<std::size_t>(Histogram::Count)> auBuckets{};
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Histogram::Count)> auHistogramNs{};
+    };
+
+    /**
+     * @brief Shard used by the current thread: the threads are spread over the shards in turn, to avoid sharing cache lines
+     */
+    std::size_t stats_shard_index() {
+        static std::atomic<std::size_t> uNextShard{0};
+        thread_local std::size_t const uShard{ uNextShard++ % s_uStatsShardsCount };
+        return uShard;
+    }
+
+    std::size_t histogram_bucket(std::chrono::nanoseconds a_Duration) {
+        std::size_t uBucket{0};
+        for(auto uMicroseconds = static_cast<std::uint64_t>(a_Duration.count()) / 1000; uMicroseconds > 0; uMicroseconds >>= 1) {
+            ++uBucket;
+        }
+        return std::min(uBucket, emb::settings::LatencyHistogram::BucketsCount - 1);
+    }
+
+    /**
+     * @brief Performance counters of a settings file, in lock-free per-thread shards merged on query
+     */
+    class FileCounters {
+    public:
+        void add(Counter a_eCounter, std::uint64_t a_uValue = 1) {
+            m_aShards[stats_shard_index()].auCounters[static_cast<std::size_t>(a_eCounter)].fetch_add(a_uValue, std::memory_order_relaxed);
+        }
+
+        void record(Histogram a_eHistogram, std::chrono::nanoseconds a_Duration) {
+            auto & rShard = m_aShards[stats_shard_index()];
+            auto const uHistogram = static_cast<std::size_t>(a_eHistogram);
+            rShard.auBuckets[uHistogram][histogram_bucket(a_Duration)].fetch_add(1, std::memory_order_relaxed);
+            rShard.auHistogramNs[uHistogram].fetch_add(static_cast<std::uint64_t>(a_Duration.count()), std::memory_order_relaxed);
+        }
+
+        std::uint64_t get(Counter a_eCounter) const {
+            std::uint64_t uValue{0};
+            for(auto const& shard : m_aShards) {
+                uValue += shard.auCounters[static_cast<std::size_t>(a_eCounter)].load(std::memory_order_relaxed);
+            }
+            return uValue;
+        }
+
+        emb::settings::LatencyHistogram get(Histogram a_eHistogram) const {
+            emb::settings::LatencyHistogram stHistogram{};
+            auto const uHistogram = static_cast<std::size_t>(a_eHistogram);
+            for(auto const& shard : m_aShards) {
+                for(std::size_t uBucket = 0; uBucket < emb::settings::LatencyHistogram::BucketsCount; ++uBucket) {
+                    auto const uCount = shard.auBuckets[uHistogram][uBucket].load(std::memory_order_relaxed);
+                    stHistogram.auCounts[uBucket] += uCount;
+                    stHistogram.uCount += uCount;
+                }
+                stHistogram.total += std::chrono::nanoseconds{ shard.auHistogramNs[uHistogram].load(std::memory_order_relaxed) };
+            }
+            return stHistogram;
+        }
+
+    private:
+        std::array<StatsShard, s_uStatsShardsCount> m_aShards{};
+    };
+
+    /**
+     * @brief Measure the duration of a scope
+     */
+    class ScopeTimer {
+    public:
+        ScopeTimer() : m_Start{ std::chrono::steady_clock::now() } {}
+        std::chrono::nanoseconds elapsed() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start);
+        }
+    private:
+        std::chrono::steady_clock::time_point m_Start;
+    };
+
+    std::atomic<bool>& contention_profiling() {
+        static std::atomic<bool> bContentionProfiling{false};
+        return bContentionProfiling;
+    }
+
+    /**
+     * @brief Durations recorded by the contention profiler
+     */
+    struct LockDurations {
+        std::uint64_t uCount{0};
+        std::chrono::nanoseconds total{};
+        std::chrono::nanoseconds max{};
+
+        void add(std::chrono::nanoseconds a_Duration) {
+            ++uCount;
+            total += a_Duration;
+            max = std::max(max, a_Duration);
+        }
+    };
+
+    std::atomic<bool>& tracing() {
+        static std::atomic<bool> bTracing{false};
+        return bTracing;
+    }
+
+    std::shared_ptr<emb::settings::Tracer>& tracer() {
+        static std::shared_ptr<emb::settings::Tracer> pTracer{};
+        return pTracer;
+    }
+
+    /**
+     * @brief Span traced from its construction to its destruction, when a tracer is set
+     */
+    class TraceScope {
+    public:
+        TraceScope(emb::settings::TraceSpanType a_eType, std::string_view a_strFileName, std::size_t a_uBytes = 0) {
+            if(tracing().load(std::memory_order_relaxed)) {
+                // Kept alive until the end of the span, even if the tracer is replaced meanwhile
+                m_pTracer = std::atomic_load(&tracer());
+                if(m_pTracer) {
+                    m_stSpan.eType = a_eType;
+                    m_stSpan.strFileName = a_strFileName;
+                    m_stSpan.uBytes = a_uBytes;
+                    m_stSpan.start = std::chrono::steady_clock::now();
+                    m_pTracer->begin_span(m_stSpan);
+                }
+            }
+        }
+        TraceScope(TraceScope const&) = delete;
+        TraceScope& operator=(TraceScope const&) = delete;
+        ~TraceScope() {
+            if(m_pTracer) {
+                m_stSpan.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_stSpan.start);
+                m_pTracer->end_span(m_stSpan);
+            }
+        }
+        void set_bytes(std::size_t a_uBytes) {
+            m_stSpan.uBytes = a_uBytes;
+        }
+    private:
+        std::shared_ptr<emb::settings::Tracer> m_pTracer{};
+        emb::settings::TraceSpan m_stSpan{};
+    };
+
+    std::string json_quoted(std::string_view a_str) {
+        std::string strQuoted{ "\"" };
+        for(char const c : a_str) {
+            if('"' == c || '\\' == c) {
+                strQuoted.push_back('\\');
+            }
+            strQuoted.push_back(c);
+        }
+        return strQuoted + "\"";
+    }
+
+    /**
+     * @brief Estimated memory used by a node of a std::map: the value and the links of the red-black tree
+     */
+    template<typename Map>
+    std::size_t map_memory_usage(Map const& a_Map) {
+        return a_Map.size() * (sizeof(typename Map::value_type) + 4 * sizeof(void*));
+    }
+
+    /**
+     * @brief Tell if a character is a whitespace of the "C" locale: ' ', '\t', '\n', '\v', '\f' or '\r'
+     */
+    constexpr bool is_c_space(char a_c) {
+        return ' ' == a_c || static_cast<unsigned char>(a_c - '\t') <= '\r' - '\t';
+    }
+
+    std::size_t count_spaces_scalar(char const* a_pcData, std::size_t a_uSize) {
+        std::size_t uCount{0};
+        for(std::size_t i = 0; i < a_uSize; ++i) {
+            uCount += is_c_space(a_pcData[i]);
+        }
+        return uCount;
+    }
+
+#ifdef EMBSETTINGS_AVX2_DISPATCH
+    // Compiled for AVX2 whatever the target flags, only called if the CPU supports it
+    __attribute__((target("avx2")))
+    std::size_t count_spaces_avx2(char const* a_pcData, std::size_t a_uSize) {
+        __m256i const space = _mm256_set1_epi8(' ');
+        __m256i const tab = _mm256_set1_epi8('\t');
+        __m256i const controlRange = _mm256_set1_epi8('\r' - '\t');
+        std::size_t uCount{0}, i{0};
+        for(; i + 32 <= a_uSize; i += 32) {
+            __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a_pcData + i));
+            // '\t' to '\r': unsigned (c - '\t') <= '\r' - '\t', i.e. min(c - '\t', '\r' - '\t') == c - '\t'
+            __m256i const offset = _mm256_sub_epi8(chunk, tab);
+            __m256i const matches = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(_mm256_min_epu8(offset, controlRange), offset));
+            uCount += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(matches))));
+        }
+        return uCount + count_spaces_scalar(a_pcData + i, a_uSize - i);
+    }
+#endif
+
+#ifdef EMBSETTINGS_NEON
+    std::size_t count_spaces_neon(char const* a_pcData, std::size_t a_uSize) {
+        uint8x16_t const space = vdupq_n_u8(' ');
+        uint8x16_t const tab = vdupq_n_u8('\t');
+        uint8x16_t const controlRange = vdupq_n_u8('\r' - '\t');
+        std::size_t uCount{0}, i{0};
+        while(i + 16 <= a_uSize) {
+            // Matches are accumulated in 8 bits lanes, which would overflow after 255 chunks
+            uint8x16_t accumulator = vdupq_n_u8(0);
+            for(std::size_t uChunks = 0; uChunks < 255 && i + 16 <= a_uSize; ++uChunks, i += 16) {
+                uint8x16_t const chunk = vld1q_u8(reinterpret_cast<uint8_t const*>(a_pcData + i));
+                uint8x16_t const matches = vorrq_u8(vceqq_u8(chunk, space), vcleq_u8(vsubq_u8(chunk, tab), controlRange));
+                accumulator = vsubq_u8(accumulator, matches);
+            }
+            uCount += vaddlvq_u8(accumulator);
+        }
+        return uCount + count_spaces_scalar(a_pcData + i, a_uSize - i);
+    }
+#endif
+
+    /**
+     * @brief Change of a tree node found by diff_trees
+     */
+    struct TreeChange {
+        string strPath{};           ///< Path of the changed node
+        bool bSubtree{false};       ///< true if the whole subtree has been added, removed or replaced
+    };
+
+    string join_path(string const& a_strPath, string const& a_strKey) {
+        return a_strPath.empty() ? a_strKey : a_strPath + "." + a_strKey;
+    }
+
+    bool has_duplicate_keys(boost::property_tree::ptree const& a_Tree) {
+        string const* pstrPrevious{nullptr};
+        for(auto it = a_Tree.ordered_begin(); it != a_Tree.not_found(); ++it) {
+            if(pstrPrevious && *pstrPrevious == it->first) {
+                return true;
+            }
+            pstrPrevious = &it->first;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Build a tree from the nodes given by parse_tree()
+     * @param a_rvecNodes   Parsed nodes, their keys and data are moved into the tree
+     * @param a_ruIndex     Index of the node to build, then of the node following its subtree
+     * @param a_rTree       Tree receiving the node
+     */
+    void build_tree(vector<emb::settings::internal::ParsedNode>& a_rvecNodes, size_t& a_ruIndex, boost::property_tree::ptree& a_rTree) {
+        auto& rNode = a_rvecNodes[a_ruIndex++];
+        a_rTree.data() = std::move(rNode.strData);
+        for(size_t i = 0; i < rNode.uChildren; ++i) {
+            auto& rChild = a_rTree.push_back(make_pair(std::move(a_rvecNodes[a_ruIndex].strKey), boost::property_tree::ptree{}))->second;
+            build_tree(a_rvecNodes, a_ruIndex, rChild);
+        }
+    }
+
+    /**
+     * @brief Tell if a node stores a listened setting element, or contains the key of one
+     * @param a_mapKeyIndex Keys of the listened setting elements
+     * @param a_strPath     Path of the node
+     */
+    bool is_listened_path(map<string_view, string_view, less<>> const& a_mapKeyIndex, string const& a_strPath) {
+        if(a_mapKeyIndex.count(a_strPath) > 0) {
+            return true;
+        }
+        string const strPrefix{ a_strPath + "." };
+        auto const it = a_mapKeyIndex.lower_bound(strPrefix);
+        return it != a_mapKeyIndex.end() && 0 == it->first.compare(0, strPrefix.size(), strPrefix);
+    }
+
+    /**
+     * @brief Compute the changes between two trees
+     * @details Children with unique keys are matched by key and compared recursively. Sequences of children sharing
+     *          the same key (vectors) are compared as a whole and reported as a change of their parent.
+     *          The subtrees that neither store nor contain a listened setting element are skipped without being walked.
+     * @param a_Old         Old tree
+     * @param a_New         New tree
+     * @param a_strPath     Path of the compared trees
+     * @param a_mapKeyIndex Keys of the listened setting elements
+     * @param a_bListened   The compared trees are inside the subtree of a listened setting element
+     * @param a_rvecChanges Found changes
+     */
+    void diff_trees(boost::property_tree::ptree const& a_Old, boost::property_tree::ptree const& a_New, string const& a_strPath,
+                    map<string_view, string_view, less<>> const& a_mapKeyIndex, bool a_bListened, vector<TreeChange>& a_rvecChanges) {
+        if(a_Old.data() != a_New.data()) {
+            a_rvecChanges.push_back(TreeChange{ a_strPath, false });
+        }
+        if(a_Old.empty() && a_New.empty()) {
+            return;
+        }
+        if(has_duplicate_keys(a_Old) || has_duplicate_keys(a_New)) {
+            if(a_Old.size() != a_New.size() || !std::equal(a_Old.begin(), a_Old.end(), a_New.begin())) {
+                a_rvecChanges.push_back(TreeChange{ a_strPath, true });
+            }
+            return;
+        }
+        for(auto const& oldChild : a_Old) {
+            string strChildPath{ join_path(a_strPath, oldChild.first) };
+            bool const bChildListened{ a_bListened || a_mapKeyIndex.count(strChildPath) > 0 };
+            if(!bChildListened && !is_listened_path(a_mapKeyIndex, strChildPath)) {
+                continue;
+            }
+            if(auto itNew = a_New.find(oldChild.first); itNew != a_New.not_found()) {
+                diff_trees(oldChild.second, itNew->second, strChildPath, a_mapKeyIndex, bChildListened, a_rvecChanges);
+            }
+            else {
+                a_rvecChanges.push_back(TreeChange{ std::move(strChildPath), true });
+            }
+        }
+        for(auto const& newChild : a_New) {
+            if(a_Old.find(newChild.first) == a_Old.not_found()) {
+                string strChildPath{ join_path(a_strPath, newChild.first) };
+                if(a_bListened || is_listened_path(a_mapKeyIndex, strChildPath)) {
+                    a_rvecChanges.push_back(TreeChange{ std::move(strChildPath), true });
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Header of a sidecar file, followed by the values. Its size keeps the values aligned for any arithmetic type.
+     */
+    struct SidecarHeader {
+        char acMagic[8]{ 'E', 'M', 'B', 'S', 'V', 'E', 'C', '1' };
+        std::uint32_t uElementSize{0};
+        std::uint32_t uReserved{0};
+        std::uint64_t uCount{0};
+        std::uint64_t uReserved2{0};
+    };
+    static_assert(sizeof(SidecarHeader) == 32, "Unexpected sidecar header size");
+
+    /**
+     * @brief Content of a sidecar file, mapped in memory (or read in a buffer where mmap is not available)
+     */
+    struct MappedSidecar : emb::settings::internal::SidecarContent {
+        void* pMapping{nullptr};
+        size_t uMappingSize{0};
+        vector<char> vecBuffer{};
+
+        MappedSidecar() = default;
+        MappedSidecar(MappedSidecar const&) = delete;
+        MappedSidecar& operator=(MappedSidecar const&) = delete;
+        ~MappedSidecar() {
+#ifdef EMBSETTINGS_MMAP
+            if(pMapping) {
+                ::munmap(pMapping, uMappingSize);
+            }
+#endif
+        }
+    };
+
+    shared_ptr<MappedSidecar> map_sidecar(string const& a_strPath) {
+        auto pSidecar = make_shared<MappedSidecar>();
+        char const* pcContent{nullptr};
+        size_t uContentSize{0};
+#ifdef EMBSETTINGS_MMAP
+        int const fd = ::open(a_strPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0) {
+            return nullptr;
+        }
+        struct stat stStat{};
+        if(0 != ::fstat(fd, &stStat) || stStat.st_size < static_cast<off_t>(sizeof(SidecarHeader))) {
+            ::close(fd);
+            return nullptr;
+        }
+        void* pMapping = ::mmap(nullptr, static_cast<size_t>(stStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(MAP_FAILED == pMapping) {
+            return nullptr;
+        }
+        pSidecar->pMapping = pMapping;
+        pSidecar->uMappingSize = static_cast<size_t>(stStat.st_size);
+        pcContent = static_cast<char const*>(pMapping);
+        uContentSize = pSidecar->uMappingSize;
+#else
+        std::ifstream is(a_strPath, std::ios::binary);
+        if(!is.is_open()) {
+            return nullptr;
+        }
+        pSidecar->vecBuffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        pcContent = pSidecar->vecBuffer.data();
+        uContentSize = pSidecar->vecBuffer.size();
+        if(uContentSize < sizeof(SidecarHeader)) {
+            return nullptr;
+        }
+#endif
+        SidecarHeader stHeader{};
+        SidecarHeader const stExpectedHeader{};
+        std::memcpy(&stHeader, pcContent, sizeof(stHeader));
+        if(0 != std::memcmp(stHeader.acMagic, stExpectedHeader.acMagic, sizeof(stHeader.acMagic)) || 0 == stHeader.uElementSize ||
+                stHeader.uCount > (uContentSize - sizeof(SidecarHeader)) / stHeader.uElementSize) {
+            return nullptr;
+        }
+        pSidecar->pData = pcContent + sizeof(SidecarHeader);
+        pSidecar->uElementSize = stHeader.uElementSize;
+        pSidecar->uCount = static_cast<size_t>(stHeader.uCount);
+        return pSidecar;
+    }
+
+    /**
+     * @brief Write a sidecar file in a temporary file renamed over the previous one: the mapped previous content stays valid
+     */
+    bool store_sidecar(string const& a_strPath, void const* a_pData, size_t a_uElementSize, size_t a_uCount) {
+        string const strTmpPath{ a_strPath + ".tmp" };
+        {
+            std::ofstream os(strTmpPath, std::ios::binary | std::ios::trunc);
+            if(!os.is_open()) {
+                return false;
+            }
+            SidecarHeader stHeader{};
+            stHeader.uElementSize = static_cast<std::uint32_t>(a_uElementSize);
+            stHeader.uCount = a_uCount;
+            os.write(reinterpret_cast<char const*>(&stHeader), sizeof(stHeader));
+            os.write(static_cast<char const*>(a_pData), static_cast<std::streamsize>(a_uElementSize * a_uCount));
+            if(!os.flush()) {
+                return false;
+            }
+        }
+        std::error_code errorCode{};
+        std::filesystem::rename(strTmpPath, a_strPath, errorCode);
+        return !errorCode;
+    }
+
+}
+
+namespace emb {
+    namespace settings {
+        namespace internal {
+
+            struct SettingElementInfo {
+                emb::settings::internal::creation_method<emb::settings::internal::SettingElement> funcCreate{};
+                string_view strKey{};               ///< Interned key, given on registration
+                std::function<void(void)> funcReadLinked{};
+                std::function<void(void)> funcWriteLinked{};
+                vector<std::function<void(boost::property_tree::ptree const&, boost::property_tree::ptree const&)>> vecSubscribers{};
+                vector<std::function<void(boost::property_tree::ptree const&)>> vecPushedLinks{};
+                vector<std::function<void(void)>> vecSidecarSubscribers{};  ///< Subscribers of a vector stored in a sidecar
+            };
+
+            /**
+             * @brief Sidecar file written during a transaction, stored on commit
+             */
+            struct PendingSidecar {
+                bool bRemove{false};
+                size_t uElementSize{0};
+                size_t uCount{0};
+                vector<char> vecData{};
+            };
+
+            struct SettingsFileInfo {
+                emb::settings::internal::creation_method<emb::settings::internal::SettingsFile> funcCreate{};
+                recursive_mutex mutex{};
+                bool bTransactionPending{false};
+                boost::property_tree::ptree backupTree{};
+                boost::property_tree::ptree tree{};
+                map<string_view, SettingElementInfo, less<>> elm_info{};     ///< By interned element name
+                map<string_view, string_view, less<>> key_index{};          ///< Interned key of each listened element -> element name, built on first notification
+                bool bKeyIndexStale{true};          ///< An element has been listened to since key_index was built
+                size_t uListenersCount{0};          ///< Number of subscribers and of variables linked in LinkMode::AutoRefresh
+                bool bDirty{false};                 ///< The tree may have been modified since it was last written
+                bool bEvicted{false};               ///< The tree has been unloaded to meet the memory budget
+                bool bCompacted{false};             ///< The unloaded tree is kept in compactTree
+                emb::settings::internal::CompactTree compactTree{};         ///< Compact copy of the tree of an unloaded file
+                std::filesystem::file_time_type compactWriteTime{};         ///< Modification time of the file when it was compacted
+                std::uintmax_t uCompactFileSize{0};                         ///< Size of the file when it was compacted
+                size_t uLockDepth{0};               ///< Number of trees given by lock_tree and not released yet
+                size_t uContentSize{0};             ///< Size of strFilecontent
+                std::atomic<size_t> uMemoryUsage{0};        ///< Estimated memory used by the trees and the serialized content
+                std::atomic<bool> bMemoryStale{true};       ///< The file changed since its memory was last measured
+                TreeMemory stTreeMemory{};                  ///< Memory used by tree, measured on demand
+                TreeMemory stBackupTreeMemory{};            ///< Memory used by backupTree, measured on demand
+                mutable FileCounters counters{};            ///< Performance counters
+                bool bReadOnce{false};                      ///< The file has been read since the start of the program
+                // Contention profiler. The holders and waiters are interned element names or operation names (string literals).
+                std::atomic<char const*> pszHolder{nullptr};                ///< Holder of the lock, set while profiling
+                std::chrono::steady_clock::time_point holdStart{};
+                map<char const*, LockDurations> mapHolds{};                 ///< Holder -> durations of its holds
+                map<pair<char const*, char const*>, LockDurations> mapWaits{}; ///< Holder, waiter -> durations of the waits
+                std::atomic<std::uint64_t> uLastAccess{0};  ///< Value of the access clock on last lock_tree
+                map<string, shared_ptr<MappedSidecar>> sidecars{};          ///< Mapped sidecar files, by element name
+                map<string, PendingSidecar> pendingSidecars{};              ///< Sidecar files written by the pending transaction
+
+                emb::settings::FileType eFileType{};         ///< Given on registration
+                string_view strFileName{};          ///< Interned name of the file, set on first access
+                string strFullFileName{};
+                int iVersion{0};
+                emb::settings::version_clbk_t pVersionClbk{nullptr};
+                std::stringstream strFilecontent{};
+
+                bool parse_content(std::istream & a_streamInput, size_t a_uBytes, boost::property_tree::ptree & a_rTree) const {
+                    // Nothing to parse in a file not created yet: checked beforehand to avoid a parse error thrown on each first load
+                    if (std::istream::traits_type::eof() == a_streamInput.peek()) {
+                        return false;
+                    }
+                    TraceScope const span{ emb::settings::TraceSpanType::Parse, strFileName, a_uBytes };
+                    ScopeTimer const timer{};
+                    vector<ParsedNode> vecNodes{};
+                    bool const bRes{ parse_tree(eFileType, a_streamInput, vecNodes) };
+                    if(bRes) {
+                        size_t uIndex{0};
+                        a_rTree.clear();
+                        build_tree(vecNodes, uIndex, a_rTree);
+                    }
+                    counters.add(Counter::ParseNs, static_cast<std::uint64_t>(timer.elapsed().count()));
+                    return bRes;
+                }
+
+                void migrate_version() {
+                    auto iOldVersion = tree.get<int>(version_element_name(), 0);
+                    if(iOldVersion != iVersion && pVersionClbk) {
+                        TraceScope const span{ emb::settings::TraceSpanType::Migration, strFileName };
+                        if(pVersionClbk(iOldVersion, iVersion)) {
+                            tree.put<int>(version_element_name(), iVersion);
+                            write_file();
+                        }
+                    }
+                }
+
+                void read_file() {
+                    // The sidecars may have been replaced too: they are mapped again on next access
+                    sidecars.clear();
+                    TraceScope span{ emb::settings::TraceSpanType::Load, strFileName };
+                    std::ifstream is(strFullFileName, std::ios::binary);
+                    if (is.is_open()) {
+                        std::stringstream buffer;
+                        strFilecontent.str(std::string()); // clear content
+                        strFilecontent.clear(); // clear internal status (eof...)
+                        strFilecontent << is.rdbuf();
+                    }
+                    uContentSize = strFilecontent.str().size();
+                    span.set_bytes(uContentSize);
+                    if(!parse_content(strFilecontent, uContentSize, tree)) {
+                        tree = decltype(tree)();
+                    }
+                    if(bReadOnce) {
+                        counters.add(Counter::Reloads);
+                    }
+                    bReadOnce = true;
+                    bEvicted = false;
+                    drop_compact_tree();
+                    migrate_version();
+                    invalidate_memory_usage();
+                }
+
+                /**
+                 * @brief Mark the memory used by the file as changed: it is measured again when the memory is queried or budgeted
+                 */
+                void invalidate_memory_usage() {
+                    bMemoryStale.store(true, std::memory_order_relaxed);
+                }
+
+                /**
+                 * @brief Estimate again the memory used by the file, if it changed since the last estimation. The file must be locked.
+                 */
+                void measure_memory_usage() {
+                    if(!bMemoryStale.exchange(false, std::memory_order_relaxed)) {
+                        return;
+                    }
+                    stTreeMemory = measure_tree(tree);
+                    stBackupTreeMemory = measure_tree(backupTree);
+                    size_t const uNewUsage{ stTreeMemory.uBytes + stBackupTreeMemory.uBytes + uContentSize + compact_tree_memory_usage() };
+                    size_t const uOldUsage{ uMemoryUsage.exchange(uNewUsage) };
+                    memory_usage() += uNewUsage;
+                    memory_usage() -= uOldUsage;
+                }
+
+                size_t compact_tree_memory_usage() const {
+                    return bCompacted ? compactTree.memory_usage() : 0;
+                }
+
+                void drop_compact_tree() {
+                    if(bCompacted) {
+                        emb::settings::internal::CompactTree{}.swap(compactTree);
+                        bCompacted = false;
+                    }
+                }
+
+                /**
+                 * @brief Unload the tree and the serialized content. The file must be locked.
+                 * @details The tree is first replaced by a compact copy, restored on next access if the file did not change on disk.
+                 *          An unloaded file that is still over the budget drops this copy: it is read again on next access.
+                 */
+                void evict() {
+                    if(bEvicted) {
+                        drop_compact_tree();
+                    }
+                    else {
+                        // The tree is clean: it is the content of the file, unless it cannot be written
+                        std::error_code errorWriteTime{}, errorFileSize{};
+                        compactWriteTime = std::filesystem::last_write_time(strFullFileName, errorWriteTime);
+                        uCompactFileSize = std::filesystem::file_size(strFullFileName, errorFileSize);
+                        if(!errorWriteTime && !errorFileSize) {
+                            measure_memory_usage();
+                            compactTree.assign(tree);
+                            // Small trees cost less than the arena and the key index of their copy
+                            bCompacted = compactTree.memory_usage() < stTreeMemory.uBytes;
+                            if(!bCompacted) {
+                                emb::settings::internal::CompactTree{}.swap(compactTree);
+                            }
+                        }
+                        tree = decltype(tree)();
+                        std::stringstream{}.swap(strFilecontent);
+                        sidecars.clear();
+                        uContentSize = 0;
+                        bEvicted = true;
+                    }
+                    // Measured now: the budget is checked again right after
+                    invalidate_memory_usage();
+                    measure_memory_usage();
+                }
+
+                /**
+                 * @brief Load an unloaded file again: from its compact copy if the file did not change on disk, from the file otherwise
+                 * @details The serialized content is not restored: the next write of the file is not compared to it. The file must be locked.
+                 */
+                void load_evicted() {
+                    std::error_code errorWriteTime{}, errorFileSize{};
+                    if(bCompacted && compactWriteTime == std::filesystem::last_write_time(strFullFileName, errorWriteTime) && !errorWriteTime
+                            && uCompactFileSize == std::filesystem::file_size(strFullFileName, errorFileSize) && !errorFileSize) {
+                        compactTree.to_ptree(tree);
+                        bEvicted = false;
+                        drop_compact_tree();
+                        invalidate_memory_usage();
+                    }
+                    else {
+                        read_file();
+                    }
+                }
+
+                emb::settings::FileStats stats(string_view a_strFileName) const {
+                    emb::settings::FileStats stStats{};
+                    stStats.strFileName = string{ a_strFileName };
+                    stStats.uReads = counters.get(Counter::Reads);
+                    stStats.uWrites = counters.get(Counter::Writes);
+                    stStats.uResets = counters.get(Counter::Resets);
+                    stStats.uLocks = counters.get(Counter::Locks);
+                    stStats.lockWait = std::chrono::nanoseconds{ counters.get(Counter::LockWaitNs) };
+                    stStats.serialize = std::chrono::nanoseconds{ counters.get(Counter::SerializeNs) };
+                    stStats.uBytesWritten = counters.get(Counter::BytesWritten);
+                    stStats.uSkippedWrites = counters.get(Counter::SkippedWrites);
+                    stStats.parse = std::chrono::nanoseconds{ counters.get(Counter::ParseNs) };
+                    stStats.uReloads = counters.get(Counter::Reloads);
+                    stStats.lockWaitHistogram = counters.get(Histogram::LockWait);
+                    stStats.serializeHistogram = counters.get(Histogram::Serialize);
+                    stStats.diskWriteHistogram = counters.get(Histogram::DiskWrite);
+                    return stStats;
+                }
+
+                emb::settings::FileMemoryStats memory_stats(string_view a_strFileName) const {
+                    emb::settings::FileMemoryStats stStats{};
+                    stStats.strFileName = string{ a_strFileName };
+                    stStats.bLoaded = !strFullFileName.empty() && !bEvicted;
+                    stStats.uNodesCount = stTreeMemory.uNodesCount;
+                    stStats.uKeysBytes = stTreeMemory.uKeysBytes;
+                    stStats.uValuesBytes = stTreeMemory.uValuesBytes;
+                    stStats.uTreeBytes = stTreeMemory.uBytes;
+                    stStats.uBackupTreeBytes = stBackupTreeMemory.uBytes;
+                    stStats.uCompactTreeBytes = compact_tree_memory_usage();
+                    stStats.uContentBytes = uContentSize;
+                    for(auto const& sidecar : sidecars) {
+                        if(sidecar.second) {
+                            stStats.uSidecarsBytes += sidecar.second->uMappingSize + sidecar.second->vecBuffer.capacity();
+                        }
+                    }
+                    for(auto const& pending : pendingSidecars) {
+                        stStats.uSidecarsBytes += pending.second.vecData.capacity();
+                    }
+                    stStats.uCachesBytes = map_memory_usage(key_index);
+                    stStats.uTotalBytes = stStats.uTreeBytes + stStats.uBackupTreeBytes + stStats.uCompactTreeBytes + stStats.uContentBytes
+                                        + stStats.uSidecarsBytes + stStats.uCachesBytes;
+                    return stStats;
+                }
+
+                /**
+                 * @brief Memory used by the registration of the file and of its elements. The file must be locked.
+                 */
+                size_t registry_memory_usage() const {
+                    size_t uBytes{ map_memory_usage(elm_info) + string_memory_usage(strFullFileName) };
+                    for(auto const& elm : elm_info) {
+                        uBytes += elm.second.vecSubscribers.capacity() * sizeof(elm.second.vecSubscribers[0])
+                                + elm.second.vecPushedLinks.capacity() * sizeof(elm.second.vecPushedLinks[0]);
+                    }
+                    return uBytes;
+                }
+
+                /**
+                 * @brief Tell if the file can be unloaded. The file must be locked.
+                 */
+                bool is_evictable() const {
+                    return !strFullFileName.empty() && (!bEvicted || bCompacted) && !bTransactionPending && !bDirty
+                        && 0 == uLockDepth && 0 == uListenersCount;
+                }
+
+                /**
+                 * @brief Reload the file after it has been modified by another process
+                 * @return true     The file content changed and the tree has been replaced
+                 * @return false    The file is unchanged (e.g. it was written by us), unreadable or not parsable yet
+                 */
+                bool reload_file() {
+                    std::lock_guard<recursive_mutex> lock{mutex};
+                    // Not loaded yet: it will be read on first access anyway
+                    // Transaction pending: the commit will overwrite the file
+                    if(strFullFileName.empty() || bTransactionPending) {
+                        return false;
+                    }
+                    // Unloaded: it will be read again on next access, but not from its compact copy,
+                    // which a modification keeping the time and size of the file would not invalidate
+                    if(bEvicted) {
+                        drop_compact_tree();
+                        invalidate_memory_usage();
+                        return false;
+                    }
+                    std::ifstream is(strFullFileName, std::ios::binary);
+                    if (!is.is_open()) {
+                        return false;
+                    }
+                    TraceScope span{ emb::settings::TraceSpanType::Load, strFileName };
+                    std::stringstream strNewFilecontent{};
+                    strNewFilecontent << is.rdbuf();
+                    size_t const uNewContentSize{ strNewFilecontent.str().size() };
+                    span.set_bytes(uNewContentSize);
+                    // Our own writes always leave strFilecontent equal to the file content
+                    if(strNewFilecontent.str() == strFilecontent.str()) {
+                        return false;
+                    }
+                    // A partially written file does not parse: the next event will trigger a new attempt
+                    boost::property_tree::ptree newTree{};
+                    if(!parse_content(strNewFilecontent, uNewContentSize, newTree)) {
+                        return false;
+                    }
+                    tree.swap(newTree);
+                    counters.add(Counter::Reloads);
+                    strFilecontent.str(strNewFilecontent.str());
+                    uContentSize = uNewContentSize;
+                    migrate_version();
+                    invalidate_memory_usage();
+                    notify_changes(newTree, tree);
+                    return true;
+                }
+
+                /**
+                 * @brief Read the file again and notify the subscribers of the elements that changed
+                 */
+                void read_file_and_notify() {
+                    // During a transaction, the readers keep seeing backupTree: the commit notifies the changes
+                    if(bTransactionPending || 0 == uListenersCount) {
+                        read_file();
+                        return;
+                    }
+                    // The old tree is moved out rather than copied: it is replaced anyway
+                    boost::property_tree::ptree oldTree{};
+                    oldTree.swap(tree);
+                    read_file();
+                    notify_changes(oldTree, tree);
+                }
+
+                /**
+                 * @brief Get the tree seen by the readers: during a transaction, they see the tree as it was before the transaction
+                 */
+                boost::property_tree::ptree const& readers_tree() const {
+                    return bTransactionPending ? backupTree : tree;
+                }
+
+                void write_file() {
+                    EMBSETTINGS_TRY {
+                        std::stringstream strTmpFilecontent{};
+                        std::optional<TraceScope> serializeSpan{ std::in_place, emb::settings::TraceSpanType::Serialize, strFileName };
+                        ScopeTimer const serializeTimer{};
+                        switch (eFileType) {
+                        case emb::settings::FileType::XML:
+                            boost::property_tree::write_xml(strTmpFilecontent, tree,
+                                boost::property_tree::xml_writer_settings<decltype(tree)::key_type>(' ', 4));
+                            break;
+                        case emb::settings::FileType::JSON:
+                            boost::property_tree::write_json(strTmpFilecontent, tree);
+                            break;
+                        case emb::settings::FileType::INI:
+                            boost::property_tree::write_ini(strTmpFilecontent, tree);
+                            break;
+                        }
+                        auto const serializeDuration = serializeTimer.elapsed();
+                        counters.add(Counter::SerializeNs, static_cast<std::uint64_t>(serializeDuration.count()));
+                        counters.record(Histogram::Serialize, serializeDuration);
+                        size_t const uBytes{ strTmpFilecontent.str().size() };
+                        serializeSpan->set_bytes(uBytes);
+                        serializeSpan.reset();
+                        bool bChanged{};
+                        {
+                            TraceScope const compareSpan{ emb::settings::TraceSpanType::Compare, strFileName, uBytes };
+                            bChanged = strTmpFilecontent.str() != strFilecontent.str();
+                        }
+                        if (bChanged) {
+                            ScopeTimer const diskWriteTimer{};
+                            std::ofstream os(strFullFileName, std::ios::binary);
+                            if (os.is_open()) {
+                                {
+                                    TraceScope const diskWriteSpan{ emb::settings::TraceSpanType::DiskWrite, strFileName, uBytes };
+                                    os << strTmpFilecontent.str();
+                                }
+                                {
+                                    TraceScope const flushSpan{ emb::settings::TraceSpanType::Flush, strFileName, uBytes };
+                                    os.close();
+                                }
+                                counters.add(Counter::BytesWritten, uBytes);
+                            }
+                            counters.record(Histogram::DiskWrite, diskWriteTimer.elapsed());
+                        }
+                        else {
+                            counters.add(Counter::SkippedWrites);
+                        }
+                        strFilecontent.str(strTmpFilecontent.str());
+                        uContentSize = strFilecontent.str().size();
+                        bDirty = false;
+                        invalidate_memory_usage();
+                    }
+                    EMBSETTINGS_CATCH_ALL {
+                    }
+                }
+
+                friend ostream& operator<<(ostream & a_streamOutput, SettingsFileInfo & a_stFileInfo) {
+                    a_stFileInfo.read_file();
+                    a_streamOutput << a_stFileInfo.strFilecontent.str();
+                    return a_streamOutput;
+                }
+
+                friend istream& operator>>(istream & a_streamInput, SettingsFileInfo & a_stFileInfo) {
+                    {
+                        std::ofstream os(a_stFileInfo.strFullFileName, std::ios::binary);
+                        if (os.is_open()) {
+                            os << a_streamInput.rdbuf();
+                        }
+                    }
+                    a_stFileInfo.read_file_and_notify();
+                    return a_streamInput;
+                }
+
+                /**
+                 * @brief Lock the file and give its tree, unlocked when released
+                 * @param a_bReadOnly   The tree is only read
+                 * @param a_szHolder    Interned name of the setting element or name of the operation locking the file, for the contention profiler
+                 */
+                emb::settings::internal::tree_ptr lock_tree(bool a_bReadOnly, char const* a_szHolder) {
+                    // The clock is only read when the lock is held by another thread
+                    std::chrono::nanoseconds lockWait{};
+                    if(!mutex.try_lock()) {
+                        char const* const pszBlocker{ pszHolder.load(std::memory_order_relaxed) };
+                        ScopeTimer const timer{};
+                        mutex.lock();
+                        lockWait = timer.elapsed();
+                        counters.add(Counter::LockWaitNs, static_cast<std::uint64_t>(lockWait.count()));
+                        if(contention_profiling().load(std::memory_order_relaxed)) {
+                            // The lock may also have been held outside lock_tree (e.g. by a transaction)
+                            mapWaits[{ pszBlocker ? pszBlocker : "(other)", a_szHolder }].add(lockWait);
+                        }
+                    }
+                    counters.record(Histogram::LockWait, lockWait);
+                    counters.add(Counter::Locks);
+                    counters.add(a_bReadOnly ? Counter::Reads : Counter::Writes);
+                    if(contention_profiling().load(std::memory_order_relaxed) && 0 == uLockDepth) {
+                        pszHolder.store(a_szHolder, std::memory_order_relaxed);
+                        holdStart = std::chrono::steady_clock::now();
+                    }
+                    load();
+                    ++uLockDepth;
+                    // The clock only advances when another file has been locked since the last access to this one:
+                    // the accesses in a row to the same file do not write the shared counter
+                    if(uLastAccess.load(std::memory_order_relaxed) != access_clock().load(std::memory_order_relaxed)) {
+                        uLastAccess.store(access_clock().fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    }
+                    // Only the trees given for writing need to be serialized when unlocked
+                    // Dirtiness is tracked per file: the whole file is serialized, the in-place modifications only save the rebuild of the nodes
+                    bDirty = bDirty || !a_bReadOnly;
+                    if (bTransactionPending && a_bReadOnly) {
+                        return emb::settings::internal::tree_ptr{ &backupTree, emb::settings::internal::tree_ptr_deleter{ this } };
+                    }
+                    return emb::settings::internal::tree_ptr{ &tree, emb::settings::internal::tree_ptr_deleter{ this } };
+                }
+
+                /**
+                 * @brief Read the file on first access. The file must be locked.
+                 */
+                void load() {
+                    if(strFullFileName.empty()) {
+                        auto pFileInfo = funcCreate();
+                        strFileName = pFileInfo->get_name_m();
+                        strFullFileName = pFileInfo->get_path_m();
+                        iVersion = pFileInfo->get_version_m();
+                        pVersionClbk = pFileInfo->get_version_clbk_m();
+                        parse_jokers(strFullFileName);
+                        if(!bTransactionPending) {
+                            read_file();
+                        }
+                        watch_file(pFileInfo->get_name_m(), strFullFileName);
+                    }
+                    else if(bEvicted && !bTransactionPending) {
+                        load_evicted();
+                    }
+                }
+
+                string sidecar_path(string const& a_strElementName) const {
+                    return strFullFileName + "." + a_strElementName + ".bin";
+                }
+
+                /**
+                 * @brief List the sidecar files of the file found in a directory
+                 * @details Only the sidecars of the registered elements are looked for: the ones of another settings file
+                 *          whose name starts with the name of this one (e.g. "<file>.old") are not listed.
+                 * @param a_pathDirectory   Directory to look in
+                 * @return map<string, std::filesystem::path> Path of the sidecar files, by element name
+                 */
+                map<string, std::filesystem::path> list_sidecars(std::filesystem::path const& a_pathDirectory) const {
+                    map<string, std::filesystem::path> mapSidecars{};
+                    string const strFileName{ std::filesystem::path{ strFullFileName }.filename().string() };
+                    // A file name without directory is in the current one
+                    std::filesystem::path const pathDirectory{ a_pathDirectory.empty() ? std::filesystem::path{ "." } : a_pathDirectory };
+                    for(auto const& elm : elm_info) {
+                        std::filesystem::path pathSidecar{ pathDirectory / (strFileName + "." + string{ elm.first } + ".bin") };
+                        std::error_code errorCode{};
+                        if(std::filesystem::exists(pathSidecar, errorCode)) {
+                            mapSidecars.emplace(elm.first, std::move(pathSidecar));
+                        }
+                    }
+                    return mapSidecars;
+                }
+
+                /**
+                 * @brief Store or remove the sidecar files written by the transaction being committed. The file must be locked.
+                 * @return set<string> Names of the elements whose sidecar changed
+                 */
+                set<string> store_pending_sidecars() {
+                    set<string> setElements{};
+                    for(auto const& pending : pendingSidecars) {
+                        if(pending.second.bRemove) {
+                            std::error_code errorCode{};
+                            std::filesystem::remove(sidecar_path(pending.first), errorCode);
+                        }
+                        else {
+                            store_sidecar(sidecar_path(pending.first), pending.second.vecData.data(), pending.second.uElementSize, pending.second.uCount);
+                        }
+                        sidecars.erase(pending.first);
+                        setElements.insert(pending.first);
+                    }
+                    pendingSidecars.clear();
+                    return setElements;
+                }
+
+                void unlock_tree() {
+                    if(!bTransactionPending && bDirty) {
+                        write_file();
+                    }
+                    --uLockDepth;
+                    if(0 == uLockDepth) {
+                        if(char const* const pszReleased = pszHolder.load(std::memory_order_relaxed)) {
+                            mapHolds[pszReleased].add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - holdStart));
+                            pszHolder.store(nullptr, std::memory_order_relaxed);
+                        }
+                    }
+                    mutex.unlock();
+                    enforce_memory_budget();
+                }
+
+                /**
+                 * @brief Call the subscribers of the elements whose value changed between two versions of the tree
+                 * @details The file must be locked. Only the changed paths are mapped to the elements, through the key index.
+                 * @param a_OldTree     Tree as seen by the readers before the change
+                 * @param a_NewTree     Tree as seen by the readers after the change
+                 */
+                void notify_changes(boost::property_tree::ptree const& a_OldTree, boost::property_tree::ptree const& a_NewTree) {
+                    if(0 == uListenersCount) {
+                        return;
+                    }
+                    if(bKeyIndexStale) {
+                        key_index.clear();
+                        for(auto const& elm : elm_info) {
+                            if(!elm.second.vecSubscribers.empty() || !elm.second.vecPushedLinks.empty()) {
+                                key_index[elm.second.strKey] = elm.first;
+                            }
+                        }
+                        bKeyIndexStale = false;
+                    }
+                    if(key_index.empty()) {
+                        return;
+                    }
+                    vector<TreeChange> vecChanges{};
+                    diff_trees(a_OldTree, a_NewTree, "", key_index, false, vecChanges);
+                    set<string_view> setChangedElements{};
+                    for(auto const& change : vecChanges) {
+                        // The element stored at the changed node, or containing it (e.g. a vector or a map)
+                        for(auto pos = change.strPath.size(); pos != string::npos; pos = change.strPath.find_last_of('.', pos - 1)) {
+                            if(auto it = key_index.find(change.strPath.substr(0, pos)); it != key_index.end()) {
+                                setChangedElements.insert(it->second);
+                            }
+                            if(0 == pos) {
+                                break;
+                            }
+                        }
+                        // The elements stored inside a replaced subtree
+                        if(change.bSubtree) {
+                            string const strPrefix{ change.strPath.empty() ? string{} : change.strPath + "." };
+                            for(auto it = key_index.lower_bound(strPrefix); it != key_index.end() && 0 == it->first.compare(0, strPrefix.size(), strPrefix); ++it) {
+                                setChangedElements.insert(it->second);
+                            }
+                        }
+                    }
+                    for(auto const& elm : setChangedElements) {
+                        auto const& rElmInfo = elm_info.at(elm);
+                        for(auto const& func : rElmInfo.vecPushedLinks) {
+                            func(a_NewTree);
+                        }
+                        for(auto const& func : rElmInfo.vecSubscribers) {
+                            func(a_OldTree, a_NewTree);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Refresh the linked variables and call the subscribers of the elements whose sidecar changed. The file must be locked.
+                 * @details The sidecars contents are not part of the tree: their changes are not found by notify_changes().
+                 * @param a_setElements Names of the elements whose sidecar was written, removed or restored
+                 */
+                void notify_sidecar_changes(set<string> const& a_setElements) {
+                    for(auto const& strElement : a_setElements) {
+                        if(auto itElm = elm_info.find(strElement); itElm != elm_info.end()) {
+                            for(auto const& func : itElm->second.vecPushedLinks) {
+                                func(readers_tree());
+                            }
+                            for(auto const& func : itElm->second.vecSidecarSubscribers) {
+                                func();
+                            }
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Refresh the variables linked in LinkMode::AutoRefresh to a setting element that has just been modified
+                 * @details The file must be locked. During a transaction, the readers do not see the modification:
+                 *          the variables are refreshed by the commit.
+                 * @param a_strElementName  Name of the modified setting element
+                 */
+                void push_linked(string const& a_strElementName) {
+                    if(bTransactionPending) {
+                        return;
+                    }
+                    if(auto itElm = elm_info.find(a_strElementName); itElm != elm_info.end()) {
+                        for(auto const& func : itElm->second.vecPushedLinks) {
+                            func(tree);
+                        }
+                    }
+                }
+            };
+
+        }
+    }
+}
+
+namespace {
+
+    using emb::settings::internal::SettingElementInfo;
+    using emb::settings::internal::SettingsFileInfo;
+
+    /**
+     * @brief Settings files, by interned name
+     */
+    map<string_view, SettingsFileInfo, less<>>& files_info() {
+        static map<string_view, SettingsFileInfo, less<>> info;
+        return info;
     }
 
-    struct SettingElementInfo {
-        emb::settings::internal::creation_method<emb::settings::internal::SettingElement> funcCreate{};
-        std::function<void(void)> funcReadLinked{};
-        std::function<void(void)> funcWriteLinked{};
-    };
-
-    struct SettingsFileInfo {
-        emb::settings::internal::creation_method<emb::settings::internal::SettingsFile> funcCreate{};
-        recursive_mutex mutex{};
-        bool bTransactionPending{false};
-        boost::property_tree::ptree backupTree{};
-        boost::property_tree::ptree tree{};
-        boost::property_tree::ptree* lockedTree{nullptr};
-        map<string, SettingElementInfo> elm_info{};
-
-        emb::settings::FileType eFileType{};
-        string strFullFileName{};
-        int iVersion{0};
-        emb::settings::version_clbk_t pVersionClbk{nullptr};
-        std::stringstream strFilecontent{};
-
-        void read_file() {
-            std::ifstream is(strFullFileName, std::ios::binary);
-            if (is.is_open()) {
-                std::stringstream buffer;
-                strFilecontent.str(std::string()); // clear content
-                strFilecontent.clear(); // clear internal status (eof...)
-                strFilecontent << is.rdbuf();
-            }
-            try {
-                switch (eFileType) {
-                case emb::settings::FileType::XML:
-                    boost::property_tree::read_xml(strFilecontent, tree, boost::property_tree::xml_parser::trim_whitespace);
-                    break;
-                case emb::settings::FileType::JSON:
-                    boost::property_tree::read_json(strFilecontent, tree);
-                    break;
-                case emb::settings::FileType::INI:
-                    boost::property_tree::read_ini(strFilecontent, tree);
-                    break;
-                }
-            }
-            catch (...) {
-                tree = decltype(tree)();
-            }
-            auto iOldVersion = tree.get<int>(version_element_name(), 0);
-            if(iOldVersion != iVersion && pVersionClbk) {
-                if(pVersionClbk(iOldVersion, iVersion)) {
-                    tree.put<int>(version_element_name(), iVersion);
-                    write_file();
-                }
+    /**
+     * @brief Estimate again the memory used by the files that changed since their last estimation
+     * @details The files are only tried to be locked: a file used by another thread keeps its last estimation
+     */
+    void measure_changed_files() {
+        for(auto & file : files_info()) {
+            if(file.second.bMemoryStale.load(std::memory_order_relaxed) && file.second.mutex.try_lock()) {
+                file.second.measure_memory_usage();
+                file.second.mutex.unlock();
             }
         }
+    }
 
-        void write_file() {
-            try {
-                std::stringstream strTmpFilecontent{};
-                switch (eFileType) {
-                case emb::settings::FileType::XML:
-                    boost::property_tree::write_xml(strTmpFilecontent, tree,
-                        boost::property_tree::xml_writer_settings<decltype(tree)::key_type>(' ', 4));
-                    break;
-                case emb::settings::FileType::JSON:
-                    boost::property_tree::write_json(strTmpFilecontent, tree);
-                    break;
-                case emb::settings::FileType::INI:
-                    boost::property_tree::write_ini(strTmpFilecontent, tree);
-                    break;
+    /**
+     * @brief Unload the least recently used files until the loaded files meet the memory budget
+     * @details The files are only tried to be locked: a file used by another thread is skipped
+     */
+    void enforce_memory_budget() {
+        std::size_t const uBudget{ memory_budget() };
+        if(0 == uBudget) {
+            return;
+        }
+        measure_changed_files();
+        if(memory_usage() <= uBudget) {
+            return;
+        }
+        vector<SettingsFileInfo*> vecFiles{};
+        for(auto & file : files_info()) {
+            if(file.second.uMemoryUsage > 0) {
+                vecFiles.push_back(&file.second);
+            }
+        }
+        std::sort(vecFiles.begin(), vecFiles.end(), [](SettingsFileInfo const* a_pLeft, SettingsFileInfo const* a_pRight) {
+            return a_pLeft->uLastAccess.load(std::memory_order_relaxed) < a_pRight->uLastAccess.load(std::memory_order_relaxed);
+        });
+        // The trees are first replaced by their compact copies, which are dropped in a second pass if needed
+        for(int iPass = 0; iPass < 2; ++iPass) {
+            for(auto* pFile : vecFiles) {
+                if(memory_usage() <= uBudget) {
+                    return;
                 }
-                if (strTmpFilecontent.str() != strFilecontent.str()) {
-                    std::ofstream os(strFullFileName, std::ios::binary);
-                    if (os.is_open()) {
-                        os << strTmpFilecontent.str();
+                if(pFile->mutex.try_lock()) {
+                    // The lock depth tells if the tree is still used by this thread, which may already own the recursive mutex
+                    if(pFile->is_evictable()) {
+                        pFile->evict();
                     }
+                    pFile->mutex.unlock();
                 }
-                strFilecontent.str(strTmpFilecontent.str());
-            }
-            catch (...) {
             }
         }
+    }
+
+#ifdef __linux__
+    /**
+     * @brief Watches the directories of the loaded settings files with inotify and reloads the files modified externally
+     * @details Directories are watched instead of files so that replacements (write to a temporary file then rename)
+     *          are detected as well as in-place modifications.
+     */
+    class FileWatcher {
+    public:
+        static FileWatcher& instance() {
+            static FileWatcher watcher{};
+            return watcher;
+        }
+
+        ~FileWatcher() {
+            stop();
+        }
 
-        friend ostream& operator<<(ostream & a_streamOutput, SettingsFileInfo & a_stFileInfo) {
-            a_stFileInfo.read_file();
-            a_streamOutput << a_stFileInfo.strFilecontent.str();
-            return a_streamOutput;
+        bool start(std::chrono::milliseconds a_Debounce) {
+            lock_guard<std::mutex> lock{m_mutex};
+            if(m_thread.joinable()) {
+                return true;
+            }
+            m_fdInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            m_fdWakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if(m_fdInotify < 0 || m_fdWakeup < 0) {
+                close_fds();
+                return false;
+            }
+            m_Debounce = a_Debounce;
+            m_thread = std::thread{&FileWatcher::run, this};
+            return true;
         }
 
-        friend istream& operator>>(istream & a_streamInput, SettingsFileInfo & a_stFileInfo) {
+        void stop() {
             {
-                std::ofstream os(a_stFileInfo.strFullFileName, std::ios::binary);
-                if (os.is_open()) {
-                    os << a_streamInput.rdbuf();
+                lock_guard<std::mutex> lock{m_mutex};
+                if(!m_thread.joinable()) {
+                    return;
                 }
+                uint64_t uValue{1};
+                (void)!::write(m_fdWakeup, &uValue, sizeof(uValue));
             }
-            a_stFileInfo.read_file();
-            return a_streamInput;
+            m_thread.join();
+            lock_guard<std::mutex> lock{m_mutex};
+            close_fds();
+            m_mapDirectories.clear();
+            m_mapFiles.clear();
         }
 
-        emb::settings::internal::tree_ptr lock_tree(bool a_bReadOnly) {
-            mutex.lock();
-            if(strFullFileName.empty()) {
-                auto pFileInfo = funcCreate();
-                eFileType = pFileInfo->get_type_m();
-                strFullFileName = pFileInfo->get_path_m();
-                iVersion = pFileInfo->get_version_m();
-                pVersionClbk = pFileInfo->get_version_clbk_m();
-                parse_jokers(strFullFileName);
-                if(!bTransactionPending) {
-                    read_file();
-                }
+        void watch(std::string_view a_strFileName, std::string const& a_strFullFileName) {
+            lock_guard<std::mutex> lock{m_mutex};
+            if(!m_thread.joinable()) {
+                return;
             }
-            if (bTransactionPending && a_bReadOnly) {
-                lockedTree = &backupTree;
+            std::filesystem::path pathFile{ a_strFullFileName };
+            std::string strDirectory{ pathFile.has_parent_path() ? pathFile.parent_path().string() : std::string{"."} };
+            int iWatchDescriptor = inotify_add_watch(m_fdInotify, strDirectory.c_str(),
+                IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+            if(iWatchDescriptor >= 0) {
+                m_mapDirectories[iWatchDescriptor] = strDirectory;
+                m_mapFiles[strDirectory + "/" + pathFile.filename().string()] = a_strFileName;
             }
-            else {
-                lockedTree = &tree;
+        }
+
+    private:
+        void close_fds() {
+            if(m_fdInotify >= 0) {
+                ::close(m_fdInotify);
+                m_fdInotify = -1;
+            }
+            if(m_fdWakeup >= 0) {
+                ::close(m_fdWakeup);
+                m_fdWakeup = -1;
             }
-            return emb::settings::internal::tree_ptr{ lockedTree };
         }
 
-        void unlock_tree() {
-            if(!bTransactionPending) {
-                write_file();
+        void run() {
+            using clock = std::chrono::steady_clock;
+            // Settings files that received events, with the time of their last event
+            map<string_view, clock::time_point> mapPending{};
+            alignas(inotify_event) char buffer[4096];
+            pollfd fds[2]{ { m_fdInotify, POLLIN, 0 }, { m_fdWakeup, POLLIN, 0 } };
+            while(true) {
+                int iTimeout{ mapPending.empty() ? -1 : static_cast<int>(m_Debounce.count()) };
+                if(poll(fds, 2, iTimeout) < 0 && errno != EINTR) {
+                    break;
+                }
+                if(fds[1].revents & POLLIN) {
+                    break;
+                }
+                if(fds[0].revents & POLLIN) {
+                    ssize_t iLength{0};
+                    while((iLength = ::read(m_fdInotify, buffer, sizeof(buffer))) > 0) {
+                        lock_guard<std::mutex> lock{m_mutex};
+                        for(char* ptr = buffer; ptr < buffer + iLength; ) {
+                            auto const* pEvent = reinterpret_cast<inotify_event const*>(ptr);
+                            if(pEvent->len > 0) {
+                                if(auto itDir = m_mapDirectories.find(pEvent->wd); itDir != m_mapDirectories.end()) {
+                                    if(auto itFile = m_mapFiles.find(itDir->second + "/" + pEvent->name); itFile != m_mapFiles.end()) {
+                                        mapPending[itFile->second] = clock::now();
+                                    }
+                                }
+                            }
+                            ptr += sizeof(inotify_event) + pEvent->len;
+                        }
+                    }
+                }
+                // Reload the files whose events have settled
+                auto const now = clock::now();
+                for(auto it = mapPending.begin(); it != mapPending.end(); ) {
+                    if(now - it->second >= m_Debounce) {
+                        if(auto itFile = files_info().find(it->first); itFile != files_info().end()) {
+                            itFile->second.reload_file();
+                        }
+                        it = mapPending.erase(it);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
             }
-            lockedTree = nullptr;
-            mutex.unlock();
         }
+
+        std::mutex m_mutex{};
+        std::thread m_thread{};
+        int m_fdInotify{-1};
+        int m_fdWakeup{-1};
+        std::chrono::milliseconds m_Debounce{};
+        map<int, string> m_mapDirectories{};    ///< inotify watch descriptor -> watched directory
+        map<string, string_view> m_mapFiles{};  ///< directory/filename -> interned settings file name
     };
 
-    map<string, SettingsFileInfo>& files_info() {
-        static map<string, SettingsFileInfo> info;
-        return info;
+    void watch_file(std::string_view a_strFileName, std::string const& a_strFullFileName) {
+        FileWatcher::instance().watch(a_strFileName, a_strFullFileName);
+    }
+#else
+    void watch_file(std::string_view, std::string const&) {
     }
+#endif
 
 }
 
@@ -215,6 +1481,39 @@ namespace emb {
             return "MonitoringOperation::?";
         }
 
+        char const* str(LinkMode a_eLinkMode) {
+            #define str_LinkMode_case(__elm) case LinkMode::__elm : return #__elm;
+            switch (a_eLinkMode) {
+                str_LinkMode_case(OnDemand)
+                str_LinkMode_case(AutoRefresh)
+            }
+            return "LinkMode::?";
+        }
+
+        char const* str(VectorStorage a_eVectorStorage) {
+            #define str_VectorStorage_case(__elm) case VectorStorage::__elm : return #__elm;
+            switch (a_eVectorStorage) {
+                str_VectorStorage_case(Nodes)
+                str_VectorStorage_case(Packed)
+                str_VectorStorage_case(Sidecar)
+            }
+            return "VectorStorage::?";
+        }
+
+        char const* str(TraceSpanType a_eTraceSpanType) {
+            #define str_TraceSpanType_case(__elm) case TraceSpanType::__elm : return #__elm;
+            switch (a_eTraceSpanType) {
+                str_TraceSpanType_case(Load)
+                str_TraceSpanType_case(Parse)
+                str_TraceSpanType_case(Serialize)
+                str_TraceSpanType_case(Compare)
+                str_TraceSpanType_case(DiskWrite)
+                str_TraceSpanType_case(Flush)
+                str_TraceSpanType_case(Migration)
+            }
+            return "TraceSpanType::?";
+        }
+
         void set_joker(std::string const& a_strJoker, std::string const& a_strValue) {
             jokers()[a_strJoker] = a_strValue;
         }
@@ -235,10 +1534,193 @@ namespace emb {
             monitoring_callback() = a_fctMonitoringCallback;
         }
 
+        void set_memory_budget(std::size_t a_uBytes) {
+            memory_budget() = a_uBytes;
+            enforce_memory_budget();
+        }
+
+        std::size_t get_file_memory_usage(std::string const& a_strFileName) {
+            if (auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                lock_guard<recursive_mutex> lock{ itFile->second.mutex };
+                itFile->second.measure_memory_usage();
+                return itFile->second.uMemoryUsage;
+            }
+            return 0;
+        }
+
+        std::chrono::microseconds LatencyHistogram::bucket_upper_bound(std::size_t a_uBucket) {
+            if(a_uBucket + 1 >= BucketsCount) {
+                return std::chrono::microseconds::max();
+            }
+            return std::chrono::microseconds{ std::int64_t{1} << a_uBucket };
+        }
+
+        std::vector<FileStats> stats() {
+            std::vector<FileStats> vecStats{};
+            vecStats.reserve(files_info().size());
+            // The counters are atomic: no file lock is needed
+            for (auto const& file : files_info()) {
+                vecStats.push_back(file.second.stats(file.first));
+            }
+            return vecStats;
+        }
+
+        void start_contention_profiler() {
+            for (auto & file : files_info()) {
+                lock_guard<recursive_mutex> lock{ file.second.mutex };
+                file.second.mapHolds.clear();
+                file.second.mapWaits.clear();
+            }
+            contention_profiling() = true;
+        }
+
+        void stop_contention_profiler() {
+            contention_profiling() = false;
+        }
+
+        ContentionReport contention_report(std::size_t a_uTopN) {
+            ContentionReport stReport{};
+            for (auto & file : files_info()) {
+                lock_guard<recursive_mutex> lock{ file.second.mutex };
+                for (auto const& hold : file.second.mapHolds) {
+                    stReport.vecHolders.push_back(LockHold{ string{ file.first }, hold.first, hold.second.uCount, hold.second.total, hold.second.max });
+                }
+                for (auto const& wait : file.second.mapWaits) {
+                    stReport.vecBlockingPairs.push_back(LockWait{ string{ file.first }, wait.first.first, wait.first.second,
+                        wait.second.uCount, wait.second.total, wait.second.max });
+                }
+            }
+            auto const by_total = [](auto const& a_Left, auto const& a_Right) { return a_Left.total > a_Right.total; };
+            std::sort(stReport.vecHolders.begin(), stReport.vecHolders.end(), by_total);
+            std::sort(stReport.vecBlockingPairs.begin(), stReport.vecBlockingPairs.end(), by_total);
+            stReport.vecHolders.resize(std::min(a_uTopN, stReport.vecHolders.size()));
+            stReport.vecBlockingPairs.resize(std::min(a_uTopN, stReport.vecBlockingPairs.size()));
+            return stReport;
+        }
+
+        std::string to_json(ContentionReport const& a_stReport) {
+            std::ostringstream os{};
+            os << "{\"blocking_pairs\":[";
+            for (std::size_t uIndex = 0; uIndex < a_stReport.vecBlockingPairs.size(); ++uIndex) {
+                auto const& stWait = a_stReport.vecBlockingPairs[uIndex];
+                os << (uIndex ? "," : "") << "{\"file\":" << json_quoted(stWait.strFileName) << ",\"holder\":" << json_quoted(stWait.strHolder)
+                   << ",\"waiter\":" << json_quoted(stWait.strWaiter) << ",\"count\":" << stWait.uCount
+                   << ",\"total_ns\":" << stWait.total.count() << ",\"max_ns\":" << stWait.max.count() << "}";
+            }
+            os << "],\"holders\":[";
+            for (std::size_t uIndex = 0; uIndex < a_stReport.vecHolders.size(); ++uIndex) {
+                auto const& stHold = a_stReport.vecHolders[uIndex];
+                os << (uIndex ? "," : "") << "{\"file\":" << json_quoted(stHold.strFileName) << ",\"holder\":" << json_quoted(stHold.strHolder)
+                   << ",\"count\":" << stHold.uCount << ",\"total_ns\":" << stHold.total.count() << ",\"max_ns\":" << stHold.max.count() << "}";
+            }
+            os << "]}";
+            return os.str();
+        }
+
+        void set_tracer(std::shared_ptr<Tracer> const& a_pTracer) {
+            std::atomic_store(&tracer(), a_pTracer);
+            tracing() = static_cast<bool>(a_pTracer);
+        }
+
+        ChromeTraceExporter::ChromeTraceExporter()
+            : m_Origin{ std::chrono::steady_clock::now() } {
+        }
+
+        void ChromeTraceExporter::begin_span(TraceSpan const&) {
+            // Recorded as a complete event when it ends
+        }
+
+        void ChromeTraceExporter::end_span(TraceSpan const& a_stSpan) {
+            Event stEvent{ a_stSpan, std::hash<std::thread::id>{}(std::this_thread::get_id()) };
+            lock_guard<std::mutex> lock{ m_mutex };
+            m_vecEvents.push_back(stEvent);
+        }
+
+        std::string ChromeTraceExporter::to_json() const {
+            auto const microseconds = [](auto a_Duration) {
+                return std::chrono::duration<double, std::micro>(a_Duration).count();
+            };
+            std::ostringstream os{};
+            os << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+            lock_guard<std::mutex> lock{ m_mutex };
+            for (std::size_t uIndex = 0; uIndex < m_vecEvents.size(); ++uIndex) {
+                auto const& stSpan = m_vecEvents[uIndex].stSpan;
+                os << (uIndex ? "," : "") << "{\"name\":" << json_quoted(str(stSpan.eType)) << ",\"cat\":\"EmbSettings\",\"ph\":\"X\""
+                   << ",\"ts\":" << microseconds(stSpan.start - m_Origin) << ",\"dur\":" << microseconds(stSpan.duration)
+                   << ",\"pid\":1,\"tid\":" << m_vecEvents[uIndex].uThreadId
+                   << ",\"args\":{\"file\":" << json_quoted(stSpan.strFileName) << ",\"bytes\":" << stSpan.uBytes << "}}";
+            }
+            os << "]}";
+            return os.str();
+        }
+
+        void ChromeTraceExporter::clear() {
+            lock_guard<std::mutex> lock{ m_mutex };
+            m_vecEvents.clear();
+        }
+
+        MemoryStats memory_stats() {
+            MemoryStats stStats{};
+            stStats.vecFiles.reserve(files_info().size());
+            stStats.uRegistryBytes = map_memory_usage(files_info());
+            for (auto & file : files_info()) {
+                lock_guard<recursive_mutex> lock{ file.second.mutex };
+                file.second.measure_memory_usage();
+                stStats.vecFiles.push_back(file.second.memory_stats(file.first));
+                stStats.uRegistryBytes += file.second.registry_memory_usage();
+                stStats.uTotalBytes += stStats.vecFiles.back().uTotalBytes;
+            }
+            stStats.uRegistryBytes += map_memory_usage(jokers());
+            for (auto const& joker : jokers()) {
+                stStats.uRegistryBytes += string_memory_usage(joker.first) + string_memory_usage(joker.second);
+            }
+            {
+                auto & rTable = intern_table();
+                lock_guard<std::mutex> lock{ rTable.mutex };
+                // Strings of the deque, and nodes and buckets of the set
+                stStats.uRegistryBytes += rTable.deqStrings.size() * sizeof(std::string)
+                                        + rTable.setStrings.size() * (sizeof(std::string_view) + 2 * sizeof(void*))
+                                        + rTable.setStrings.bucket_count() * sizeof(void*);
+                for (auto const& str : rTable.deqStrings) {
+                    stStats.uRegistryBytes += string_memory_usage(str);
+                }
+            }
+            stStats.uTotalBytes += stStats.uRegistryBytes;
+            return stStats;
+        }
+
+        bool start_file_watcher(std::chrono::milliseconds a_Debounce) {
+#ifdef __linux__
+            if(!FileWatcher::instance().start(a_Debounce)) {
+                return false;
+            }
+            // Watch the files that were loaded before the watcher started
+            for(auto & file : files_info()) {
+                std::string strFullFileName{};
+                {
+                    lock_guard<recursive_mutex> lock{file.second.mutex};
+                    strFullFileName = file.second.strFullFileName;
+                }
+                if(!strFullFileName.empty()) {
+                    watch_file(file.first, strFullFileName);
+                }
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        void stop_file_watcher() {
+#ifdef __linux__
+            FileWatcher::instance().stop();
+#endif
+        }
+
         std::vector<std::string> get_file_names_list() {
             vector<string> vecFiles{};
             for (auto const& file : files_info()) {
-                vecFiles.push_back(file.first);
+                vecFiles.emplace_back(file.first);
             }
             return vecFiles;
         }
@@ -247,7 +1729,7 @@ namespace emb {
             vector<string> vecElements{};
             if (auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
                 for (auto const& elm : itFile->second.elm_info) {
-                    vecElements.push_back(elm.first);
+                    vecElements.emplace_back(elm.first);
                 }
             }
             return vecElements;
@@ -277,6 +1759,57 @@ namespace emb {
 
         namespace internal {
 
+            std::string_view intern(std::string_view a_strValue) {
+                auto & rTable = intern_table();
+                lock_guard<std::mutex> lock{ rTable.mutex };
+                if(auto it = rTable.setStrings.find(a_strValue); it != rTable.setStrings.end()) {
+                    return *it;
+                }
+                std::string_view const strInterned{ rTable.deqStrings.emplace_back(a_strValue) };
+                rTable.setStrings.insert(strInterned);
+                return strInterned;
+            }
+
+            std::string_view find_interned(std::string_view a_strValue) {
+                auto & rTable = intern_table();
+                lock_guard<std::mutex> lock{ rTable.mutex };
+                if(auto it = rTable.setStrings.find(a_strValue); it != rTable.setStrings.end()) {
+                    return *it;
+                }
+                return {};
+            }
+
+            std::string_view get_element_key(std::string_view a_strFileName, std::string_view a_strElementName) {
+                if (auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    if (auto itElm = itFile->second.elm_info.find(a_strElementName); itElm != itFile->second.elm_info.end()) {
+                        return itElm->second.strKey;
+                    }
+                }
+                return {};
+            }
+
+            std::pair<std::string_view, std::string_view> get_element_names(std::string_view a_strFileName, std::string_view a_strElementName) {
+                if (auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    if (auto itElm = itFile->second.elm_info.find(a_strElementName); itElm != itFile->second.elm_info.end()) {
+                        return { itFile->first, itElm->first };
+                    }
+                }
+                return { intern(a_strFileName), intern(a_strElementName) };
+            }
+
+            emb::settings::FileType get_file_type(std::string_view a_strFileName) {
+                if (auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    return itFile->second.eFileType;
+                }
+                return emb::settings::FileType::XML;
+            }
+
+            void count_reset(std::string const& a_strFileName) {
+                if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    itFile->second.counters.add(Counter::Resets);
+                }
+            }
+
             string& xml_vector_element_name() {
                 static string xml_vector_element_name{ "value" };
                 return xml_vector_element_name;
@@ -287,6 +1820,10 @@ namespace emb {
                 return mode;
             }
 
+            bool has_monitoring_callback() {
+                return static_cast<bool>(monitoring_callback());
+            }
+
             void call_monitoring_callback(MonitoringInformation const& a_stInformation) {
                 MonitoringCallback& fctCallback{monitoring_callback()};
                 if(fctCallback) {
@@ -297,11 +1834,8 @@ namespace emb {
             void remove_tree(boost::property_tree::ptree & a_rTree, std::string const& a_strKeyToRemove) {
                 auto pos = a_strKeyToRemove.find_last_of('.');
                 if(std::string::npos != pos) {
-                    try {
-                        a_rTree.get_child(a_strKeyToRemove.substr(0, pos)).erase(a_strKeyToRemove.substr(pos+1));
-                    }
-                    catch(boost::property_tree::ptree_bad_path&) {
-                        // get_child() may throw if the key does not exist
+                    if(auto const& parentTree = a_rTree.get_child_optional(a_strKeyToRemove.substr(0, pos))) {
+                        parentTree->erase(a_strKeyToRemove.substr(pos+1));
                     }
                 }
                 else {
@@ -309,6 +1843,126 @@ namespace emb {
                 }
             }
 
+            std::size_t count_packed_separators(std::string const& a_strPacked) {
+#if defined(EMBSETTINGS_AVX2_DISPATCH)
+                static bool const s_bAvx2{ __builtin_cpu_supports("avx2") != 0 };
+                if(s_bAvx2) {
+                    return count_spaces_avx2(a_strPacked.data(), a_strPacked.size());
+                }
+#elif defined(EMBSETTINGS_NEON)
+                return count_spaces_neon(a_strPacked.data(), a_strPacked.size());
+#endif
+                return count_spaces_scalar(a_strPacked.data(), a_strPacked.size());
+            }
+
+            void append_table_cell(std::string & a_rstrRow, std::string const& a_strCell) {
+                for(char const c : a_strCell) {
+                    if(';' == c || '\\' == c) {
+                        a_rstrRow.push_back('\\');
+                    }
+                    a_rstrRow.push_back(c);
+                }
+            }
+
+            void split_table_row(std::string const& a_strRow, std::vector<std::string> & a_rvecCells) {
+                std::size_t uCells{ 0 };
+                auto const nextCell = [&]() -> std::string& {
+                    if(uCells == a_rvecCells.size()) {
+                        a_rvecCells.emplace_back();
+                    }
+                    auto & rstrCell = a_rvecCells[uCells++];
+                    rstrCell.clear();
+                    return rstrCell;
+                };
+                std::string* pstrCell{ &nextCell() };
+                for(std::size_t uIndex = 0; uIndex < a_strRow.size(); ++uIndex) {
+                    char const c{ a_strRow[uIndex] };
+                    if('\\' == c && uIndex + 1 < a_strRow.size()) {
+                        pstrCell->push_back(a_strRow[++uIndex]);
+                    }
+                    else if(';' == c) {
+                        pstrCell = &nextCell();
+                    }
+                    else {
+                        pstrCell->push_back(c);
+                    }
+                }
+                a_rvecCells.resize(uCells);
+            }
+
+            std::shared_ptr<SidecarContent const> read_sidecar(std::string const& a_strFileName, std::string const& a_strElementName, std::size_t a_uElementSize, bool a_bWriterView) {
+                if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    auto & rFile = itFile->second;
+                    std::lock_guard<recursive_mutex> lock{rFile.mutex};
+                    rFile.load();
+                    if(auto itPending = rFile.pendingSidecars.find(a_strElementName); a_bWriterView && itPending != rFile.pendingSidecars.end()) {
+                        if(itPending->second.bRemove || a_uElementSize != itPending->second.uElementSize) {
+                            return nullptr;
+                        }
+                        auto pSidecar = make_shared<MappedSidecar>();
+                        pSidecar->vecBuffer = itPending->second.vecData;
+                        pSidecar->pData = pSidecar->vecBuffer.data();
+                        pSidecar->uElementSize = itPending->second.uElementSize;
+                        pSidecar->uCount = itPending->second.uCount;
+                        return pSidecar;
+                    }
+                    auto & rpSidecar = rFile.sidecars[a_strElementName];
+                    if(!rpSidecar) {
+                        rpSidecar = map_sidecar(rFile.sidecar_path(a_strElementName));
+                    }
+                    if(rpSidecar && a_uElementSize == rpSidecar->uElementSize) {
+                        return rpSidecar;
+                    }
+                }
+                return nullptr;
+            }
+
+            bool write_sidecar(std::string const& a_strFileName, std::string const& a_strElementName, void const* a_pData, std::size_t a_uElementSize, std::size_t a_uCount) {
+                bool bRes{false};
+                if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    auto & rFile = itFile->second;
+                    std::lock_guard<recursive_mutex> lock{rFile.mutex};
+                    rFile.load();
+                    if(rFile.bTransactionPending) {
+                        auto const* pcData = static_cast<char const*>(a_pData);
+                        rFile.pendingSidecars[a_strElementName] = PendingSidecar{ false, a_uElementSize, a_uCount,
+                            vector<char>(pcData, pcData + a_uElementSize * a_uCount) };
+                        bRes = true;
+                    }
+                    else {
+                        bRes = store_sidecar(rFile.sidecar_path(a_strElementName), a_pData, a_uElementSize, a_uCount);
+                        rFile.sidecars.erase(a_strElementName);
+                    }
+                }
+                return bRes;
+            }
+
+            void remove_sidecar(std::string const& a_strFileName, std::string const& a_strElementName) {
+                if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    auto & rFile = itFile->second;
+                    std::lock_guard<recursive_mutex> lock{rFile.mutex};
+                    rFile.load();
+                    if(rFile.bTransactionPending) {
+                        rFile.pendingSidecars[a_strElementName] = PendingSidecar{ true, 0, 0, {} };
+                    }
+                    else {
+                        std::error_code errorCode{};
+                        std::filesystem::remove(rFile.sidecar_path(a_strElementName), errorCode);
+                        rFile.sidecars.erase(a_strElementName);
+                    }
+                }
+            }
+
+            std::string sidecar_file_name(std::string const& a_strFileName, std::string const& a_strElementName) {
+                if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    auto & rFile = itFile->second;
+                    std::lock_guard<recursive_mutex> lock{rFile.mutex};
+                    rFile.load();
+                    return std::filesystem::path{ rFile.sidecar_path(a_strElementName) }.filename().string();
+                }
+                return {};
+            }
+
             std::string stringify_tree(boost::property_tree::ptree const& a_Tree) {
                 std::stringstream strTmpFilecontent;
                 boost::property_tree::write_json(strTmpFilecontent, a_Tree, false);
@@ -326,19 +1980,19 @@ namespace emb {
             ///// SettingElement                         /////
             //////////////////////////////////////////////////
 
-            std::string SettingElement::get_name_m() const {
+            std::string_view SettingElement::get_name_m() const {
                 return m_strName;
             }
 
-            std::string SettingElement::get_type_m() const {
+            std::string_view SettingElement::get_type_m() const {
                 return m_strType;
             }
 
-            std::string SettingElement::get_file_m() const {
+            std::string_view SettingElement::get_file_m() const {
                 return m_strFile;
             }
 
-            std::string SettingElement::get_key_m() const {
+            std::string_view SettingElement::get_key_m() const {
                 return m_strKey;
             }
 
@@ -362,16 +2016,51 @@ namespace emb {
 
             //}
 
-            SettingElement::SettingElement(std::string const& a_strName, std::string const& a_strType, std::string const& a_strFile, std::string const& a_strKey)
-                : m_strName{ a_strName }
-                , m_strType{ a_strType }
-                , m_strFile{ a_strFile }
-                , m_strKey{ a_strKey }
+            SettingElement::SettingElement(std::string_view a_strName, std::string_view a_strType, std::string_view a_strFile, std::string_view a_strKey)
+                : m_strName{ intern(a_strName) }
+                , m_strType{ intern(a_strType) }
+                , m_strFile{ intern(a_strFile) }
+                , m_strKey{ intern(a_strKey) }
             {}
 
             SettingElement::~SettingElement()
             {}
 
+            void SettingElement::subscribe_m(std::function<void(boost::property_tree::ptree const&, boost::property_tree::ptree const&)> const& a_funcSubscriber) {
+                if(auto itFile = files_info().find(get_file_m()); itFile != files_info().end()) {
+                    lock_guard<recursive_mutex> lock{itFile->second.mutex};
+                    if(auto itElm = itFile->second.elm_info.find(get_name_m()); itElm != itFile->second.elm_info.end()) {
+                        itElm->second.vecSubscribers.push_back(a_funcSubscriber);
+                        ++itFile->second.uListenersCount;
+                        itFile->second.bKeyIndexStale = true;
+                    }
+                }
+            }
+
+            void SettingElement::subscribe_sidecar_m(std::function<void(void)> const& a_funcSubscriber) {
+                if(auto itFile = files_info().find(get_file_m()); itFile != files_info().end()) {
+                    lock_guard<recursive_mutex> lock{itFile->second.mutex};
+                    if(auto itElm = itFile->second.elm_info.find(get_name_m()); itElm != itFile->second.elm_info.end()) {
+                        itElm->second.vecSidecarSubscribers.push_back(a_funcSubscriber);
+                        ++itFile->second.uListenersCount;
+                    }
+                }
+            }
+
+            void SettingElement::link_pushed_m(std::function<void(boost::property_tree::ptree const&)> const& a_funcRefresh) {
+                if(auto itFile = files_info().find(get_file_m()); itFile != files_info().end()) {
+                    auto & rFile = itFile->second;
+                    // Loads the file if necessary
+                    auto const pTree{ rFile.lock_tree(true, get_name_m().data()) };
+                    if(auto itElm = rFile.elm_info.find(get_name_m()); itElm != rFile.elm_info.end()) {
+                        itElm->second.vecPushedLinks.push_back(a_funcRefresh);
+                        ++rFile.uListenersCount;
+                        rFile.bKeyIndexStale = true;
+                        a_funcRefresh(*pTree);
+                    }
+                }
+            }
+
             void SettingElement::link_variable_m(std::function<void(void)> const& a_funcRead, std::function<void(void)> const& a_funcWrite) {
                 if(auto itFile = files_info().find(get_file_m()); itFile != files_info().end()) {
                     if(auto itElm = itFile->second.elm_info.find(get_name_m()); itElm != itFile->second.elm_info.end()) {
@@ -381,15 +2070,17 @@ namespace emb {
                 }
             }
 
-            bool SettingElement::register_element(char const* a_szFile, char const* a_szElement, creation_method<SettingElement> a_funcCreationMethod) {
+            bool SettingElement::register_element(char const* a_szFile, char const* a_szElement, char const* a_szKey, creation_method<SettingElement> a_funcCreationMethod) {
                 DEBUG_SELF_REGISTERING(cout << "register_element(" << a_szFile << "," << a_szElement << ")" << endl);
                 bool bRes{false};
-                if(a_funcCreationMethod()->get_key_m() == version_element_name()) {
+                if(a_szKey == version_element_name()) {
                     cerr << "SettingElement '" << a_szElement << "' cannot be registered with reserved key '" << version_element_name() << "'" << endl;
                 }
                 else if(auto itFile = files_info().find(a_szFile); itFile != files_info().end()) {
                     if(auto itElm = itFile->second.elm_info.find(a_szElement); itElm == itFile->second.elm_info.end()) {
-                        itFile->second.elm_info[a_szElement].funcCreate = a_funcCreationMethod;
+                        auto & rElmInfo = itFile->second.elm_info[intern(a_szElement)];
+                        rElmInfo.funcCreate = a_funcCreationMethod;
+                        rElmInfo.strKey = intern(a_szKey);
                         bRes = true;
                     }
                     else {
@@ -403,11 +2094,19 @@ namespace emb {
                 return bRes;
             }
 
+            bool SettingElement::register_element(char const* a_szFile, char const* a_szElement, creation_method<SettingElement> a_funcCreationMethod) {
+                bool bRes{false};
+                if(auto const& pElm = a_funcCreationMethod()) {
+                    bRes = register_element(a_szFile, a_szElement, std::string{ pElm->get_key_m() }.c_str(), a_funcCreationMethod);
+                }
+                return bRes;
+            }
+
             //////////////////////////////////////////////////
             ///// SettingsFile                           /////
             //////////////////////////////////////////////////
 
-            std::string SettingsFile::get_name_m() const {
+            std::string_view SettingsFile::get_name_m() const {
                 return m_strName;
             }
 
@@ -428,15 +2127,15 @@ namespace emb {
             }
 
             bool SettingsFile::backup_to_m(std::ostream & a_streamOutput) const {
-                return backup_file_to_stream(get_name_m(), a_streamOutput);
+                return backup_file_to_stream(std::string{ get_name_m() }, a_streamOutput);
             }
 
             bool SettingsFile::restore_from_m(std::istream & a_streamInput) const {
-                return restore_file_from_stream(get_name_m(), a_streamInput);
+                return restore_file_from_stream(std::string{ get_name_m() }, a_streamInput);
             }
 
-            SettingsFile::SettingsFile(std::string const& a_strName, FileType a_eType, std::string const& a_strPath, int a_iVersion, version_clbk_t a_pVersionClbk)
-                : m_strName{ a_strName }
+            SettingsFile::SettingsFile(std::string_view a_strName, FileType a_eType, std::string const& a_strPath, int a_iVersion, version_clbk_t a_pVersionClbk)
+                : m_strName{ intern(a_strName) }
                 , m_eType{ a_eType }
                 , m_strPath{ a_strPath }
                 , m_iVersion{ a_iVersion }
@@ -446,11 +2145,13 @@ namespace emb {
             SettingsFile::~SettingsFile()
             {}
 
-            bool SettingsFile::register_file(char const* a_szFile, creation_method<SettingsFile> a_funcCreationMethod) {
+            bool SettingsFile::register_file(char const* a_szFile, FileType a_eType, creation_method<SettingsFile> a_funcCreationMethod) {
                 DEBUG_SELF_REGISTERING(cout << "register_file(" << a_szFile << ")" << endl);
                 bool bRes{false};
                 if(auto it = files_info().find(a_szFile); it == files_info().end()) {
-                    files_info()[a_szFile].funcCreate = a_funcCreationMethod;
+                    auto & rFileInfo = files_info()[intern(a_szFile)];
+                    rFileInfo.funcCreate = a_funcCreationMethod;
+                    rFileInfo.eFileType = a_eType;
                     bRes = true;
                 }
                 else {
@@ -460,27 +2161,46 @@ namespace emb {
                 return bRes;
             }
 
+            bool SettingsFile::register_file(char const* a_szFile, creation_method<SettingsFile> a_funcCreationMethod) {
+                bool bRes{false};
+                if(auto const& pFile = a_funcCreationMethod()) {
+                    bRes = register_file(a_szFile, pFile->get_type_m(), a_funcCreationMethod);
+                }
+                return bRes;
+            }
+
             //////////////////////////////////////////////////
             ///// tree_ptr                               /////
             //////////////////////////////////////////////////
 
-            void tree_ptr_deleter::operator()(boost::property_tree::ptree* a_pObj) {
-                for(auto & file : files_info()) {
-                    if(a_pObj == file.second.lockedTree) {
-                        file.second.unlock_tree();
-                    }
+            void tree_ptr_deleter::operator()(boost::property_tree::ptree*) {
+                if(pFileInfo) {
+                    pFileInfo->unlock_tree();
                 }
             }
 
             tree_ptr get_tree(std::string const& a_strFileName, std::string const& a_strElementName, bool a_bReadOnly) {
                 if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
                     if(auto itElm = itFile->second.elm_info.find(a_strElementName); itElm != itFile->second.elm_info.end()) {
-                        return itFile->second.lock_tree(a_bReadOnly);
+                        return itFile->second.lock_tree(a_bReadOnly, itElm->first.data());
                     }
                 }
                 return nullptr;
             }
 
+            tree_ptr get_file_tree(std::string const& a_strFileName, bool a_bReadOnly) {
+                if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
+                    return itFile->second.lock_tree(a_bReadOnly, "view");
+                }
+                return nullptr;
+            }
+
+            void push_linked(tree_ptr const& a_pTree, std::string const& a_strElementName) {
+                if(auto pFileInfo = a_pTree.get_deleter().pFileInfo) {
+                    pFileInfo->push_linked(a_strElementName);
+                }
+            }
+
             boost::optional<boost::property_tree::ptree&> get_sub_tree(tree_ptr const& a_pTree, std::string const& a_strKey, bool a_bCreate) {
                 auto val = a_pTree->get_child_optional(a_strKey);
                 if(!val) {
@@ -496,35 +2216,34 @@ namespace emb {
                     rFile.mutex.lock();
 
                     // Compute the destination file path
-                    std::string outputPath;
-                    try {
-                        std::filesystem::path pathSourceFile{ rFile.strFullFileName };
-                        std::filesystem::path pathOutputFile{ a_strFolderName };
-                        pathOutputFile /= pathSourceFile.filename();
-                        outputPath = pathOutputFile.string();
-                        bRes = true;
-                    }
-                    catch(...) {
-                        bRes = false;
-                    }
+                    std::filesystem::path pathSourceFile{ rFile.strFullFileName };
+                    std::filesystem::path pathOutputFile{ a_strFolderName };
+                    pathOutputFile /= pathSourceFile.filename();
+                    std::string outputPath{ pathOutputFile.string() };
+                    bRes = true;
 
                     // Create the destination folder if necessary
-                    if(bRes) {
-                        if(!std::filesystem::exists(a_strFolderName)) {
-                            bRes = std::filesystem::create_directories(a_strFolderName);
-                        }
+                    std::error_code errorCode{};
+                    if(!std::filesystem::exists(a_strFolderName, errorCode)) {
+                        bRes = std::filesystem::create_directories(a_strFolderName, errorCode);
                     }
 
                     // Test that the file to copy exists
-                    bRes = bRes && std::filesystem::exists(rFile.strFullFileName);
+                    bRes = bRes && std::filesystem::exists(rFile.strFullFileName, errorCode);
 
                     // Copy the file
                     if(bRes) {
-                        try {
-                            std::filesystem::copy(rFile.strFullFileName, outputPath,
-                                std::filesystem::copy_options::overwrite_existing);
-                        }catch(...) {
-                            bRes = false;
+                        std::filesystem::copy(rFile.strFullFileName, outputPath,
+                            std::filesystem::copy_options::overwrite_existing, errorCode);
+                        bRes = !errorCode;
+                    }
+
+                    // Copy its sidecar files
+                    if(bRes) {
+                        for(auto const& sidecar : rFile.list_sidecars(pathSourceFile.parent_path())) {
+                            std::filesystem::copy(sidecar.second, std::filesystem::path{ a_strFolderName } / sidecar.second.filename(),
+                                std::filesystem::copy_options::overwrite_existing, errorCode);
+                            bRes = bRes && !errorCode;
                         }
                     }
 
@@ -540,39 +2259,45 @@ namespace emb {
                     rFile.mutex.lock();
 
                     // Compute the destination file path
-                    std::string outputPath;
-                    try {
-                        std::filesystem::path pathSourceFile{ rFile.strFullFileName };
-                        std::filesystem::path pathOutputFile{ a_strFolderName };
-                        pathOutputFile /= pathSourceFile.filename();
-                        outputPath = pathOutputFile.string();
-                        bRes = true;
-                    }
-                    catch(...) {
-                        bRes = false;
-                    }
+                    std::filesystem::path pathSourceFile{ rFile.strFullFileName };
+                    std::filesystem::path pathOutputFile{ a_strFolderName };
+                    pathOutputFile /= pathSourceFile.filename();
+                    std::string outputPath{ pathOutputFile.string() };
+                    bRes = true;
 
                     // Create the destination folder if necessary
-                    if(bRes) {
-                        if(!std::filesystem::exists(a_strFolderName)) {
-                            bRes = std::filesystem::create_directories(a_strFolderName);
-                        }
+                    std::error_code errorCode{};
+                    if(!std::filesystem::exists(a_strFolderName, errorCode)) {
+                        bRes = std::filesystem::create_directories(a_strFolderName, errorCode);
                     }
 
                     // Test that the file to copy exists
-                    bRes = bRes && std::filesystem::exists(rFile.strFullFileName);
+                    bRes = bRes && std::filesystem::exists(rFile.strFullFileName, errorCode);
 
                     // Copy the file
                     if(bRes) {
-                        try {
-                            std::filesystem::copy(outputPath, rFile.strFullFileName,
-                                std::filesystem::copy_options::overwrite_existing);
-                        }catch(...) {
-                            bRes = false;
+                        std::filesystem::copy(outputPath, rFile.strFullFileName,
+                            std::filesystem::copy_options::overwrite_existing, errorCode);
+                        bRes = !errorCode;
+                    }
+
+                    // Replace its sidecar files by the saved ones
+                    set<string> setSidecarElements{};
+                    if(bRes) {
+                        for(auto const& sidecar : rFile.list_sidecars(pathSourceFile.parent_path())) {
+                            std::filesystem::remove(sidecar.second, errorCode);
+                            setSidecarElements.insert(sidecar.first);
+                        }
+                        for(auto const& sidecar : rFile.list_sidecars(a_strFolderName)) {
+                            std::filesystem::copy(sidecar.second, pathSourceFile.parent_path() / sidecar.second.filename(),
+                                std::filesystem::copy_options::overwrite_existing, errorCode);
+                            bRes = bRes && !errorCode;
+                            setSidecarElements.insert(sidecar.first);
                         }
                     }
 
-                    files_info().find(a_strFileName)->second.read_file();
+                    rFile.read_file_and_notify();
+                    rFile.notify_sidecar_changes(setSidecarElements);
                     rFile.mutex.unlock();
                 }
                 return bRes;
@@ -583,7 +2308,7 @@ namespace emb {
                 if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
                     auto & rFile = itFile->second;
                     {
-                        auto const pTree{ rFile.lock_tree(true) };
+                        auto const pTree{ rFile.lock_tree(true, "backup") };
                         a_streamOutput << rFile;
                     }
                     bRes = true;
@@ -596,7 +2321,7 @@ namespace emb {
                 if(auto itFile = files_info().find(a_strFileName); itFile != files_info().end()) {
                     auto & rFile = itFile->second;
                     {
-                        auto const pTree{ rFile.lock_tree(false) };
+                        auto const pTree{ rFile.lock_tree(false, "restore") };
                         a_streamInput >> rFile;
                     }
                     bRes = true;
@@ -610,8 +2335,12 @@ namespace emb {
                     rFile.mutex.lock();
 
                     if(!rFile.bTransactionPending) {
+                        if(rFile.bEvicted) {
+                            rFile.load_evicted();
+                        }
                         rFile.bTransactionPending = true;
                         rFile.backupTree = rFile.tree;
+                        rFile.invalidate_memory_usage();
                     }
 
                     rFile.mutex.unlock();
@@ -626,7 +2355,11 @@ namespace emb {
                     if(rFile.bTransactionPending) {
                         rFile.bTransactionPending = false;
                         rFile.write_file();
+                        auto const setSidecarElements = rFile.store_pending_sidecars();
+                        rFile.notify_changes(rFile.backupTree, rFile.tree);
                         rFile.backupTree.clear();
+                        rFile.invalidate_memory_usage();
+                        rFile.notify_sidecar_changes(setSidecarElements);
                     }
 
                     rFile.mutex.unlock();
@@ -639,9 +2372,13 @@ namespace emb {
                     rFile.mutex.lock();
 
                     if(rFile.bTransactionPending) {
+                        // The readers saw backupTree during the whole transaction: nothing changes for them
                         rFile.bTransactionPending = false;
-                        rFile.tree = rFile.backupTree;
+                        rFile.tree.swap(rFile.backupTree);
                         rFile.backupTree.clear();
+                        rFile.pendingSidecars.clear();
+                        rFile.bDirty = false;
+                        rFile.invalidate_memory_usage();
                     }
 
                     rFile.mutex.unlock();
@@ -0,0 +1,186 @@
+#include "EmbSettings_compact.hpp"
+#include <cstring>
+
+namespace {
+
+    std::size_t count_nodes(boost::property_tree::ptree const& a_Tree) {
+        std::size_t uCount{ 1 };
+        for (auto const& child : a_Tree) {
+            uCount += count_nodes(child.second);
+        }
+        return uCount;
+    }
+
+}
+
+namespace emb {
+    namespace settings {
+        namespace internal {
+
+            CompactTree::CompactTree() {
+                m_vecNodes.emplace_back();
+                // Key of the root node
+                m_vecKeys.emplace_back();
+            }
+
+            CompactTree::CompactTree(boost::property_tree::ptree const& a_Tree) {
+                assign(a_Tree);
+            }
+
+            void CompactTree::assign(boost::property_tree::ptree const& a_Tree) {
+                m_vecNodes.clear();
+                m_vecPool.clear();
+                m_vecKeys.clear();
+                m_vecKeyPool.clear();
+                // Counted beforehand so that the arena is allocated once
+                m_vecNodes.reserve(count_nodes(a_Tree));
+                m_vecNodes.emplace_back();
+                m_vecKeys.emplace_back();
+                store_value(m_vecNodes.front().value, a_Tree.data());
+                // The keys of the tree are only indexed while building the document
+                KeyIndexes mapKeyIndexes{ { std::string_view{}, 0 } };
+                append_children(0, a_Tree, mapKeyIndexes);
+                m_vecPool.shrink_to_fit();
+                m_vecKeys.shrink_to_fit();
+                m_vecKeyPool.shrink_to_fit();
+            }
+
+            void CompactTree::append_children(index_t a_uNode, boost::property_tree::ptree const& a_Tree, KeyIndexes & a_rmapKeyIndexes) {
+                if (a_Tree.empty()) {
+                    return;
+                }
+                // The children are allocated together, then each one appends its own children after them
+                index_t const uFirst{ static_cast<index_t>(m_vecNodes.size()) };
+                m_vecNodes[a_uNode].uFirstChild = uFirst;
+                m_vecNodes[a_uNode].uChildrenCount = static_cast<index_t>(a_Tree.size());
+                m_vecNodes.resize(m_vecNodes.size() + a_Tree.size());
+                index_t uChild{ uFirst };
+                for (auto const& child : a_Tree) {
+                    m_vecNodes[uChild].uKey = add_key(child.first, a_rmapKeyIndexes);
+                    store_value(m_vecNodes[uChild].value, child.second.data());
+                    ++uChild;
+                }
+                uChild = uFirst;
+                for (auto const& child : a_Tree) {
+                    append_children(uChild++, child.second, a_rmapKeyIndexes);
+                }
+            }
+
+            CompactTree::index_t CompactTree::add_key(std::string const& a_strKey, KeyIndexes & a_rmapKeyIndexes) {
+                // Indexed by a view of the key of the source tree, which outlives the build
+                if (auto it = a_rmapKeyIndexes.find(a_strKey); it != a_rmapKeyIndexes.end()) {
+                    return it->second;
+                }
+                Key key{};
+                key.uSize = static_cast<std::uint32_t>(a_strKey.size());
+                // Only looked up: the keys of the registry are interned, the data keys are not added to the global table
+                key.pInterned = internal::find_interned(a_strKey).data();
+                if (nullptr == key.pInterned) {
+                    key.uOffset = static_cast<std::uint32_t>(m_vecKeyPool.size());
+                    m_vecKeyPool.insert(m_vecKeyPool.end(), a_strKey.begin(), a_strKey.end());
+                }
+                m_vecKeys.push_back(key);
+                index_t const uIndex{ static_cast<index_t>(m_vecKeys.size() - 1) };
+                a_rmapKeyIndexes.emplace(a_strKey, uIndex);
+                return uIndex;
+            }
+
+            void CompactTree::store_value(Value & a_rValue, std::string const& a_strValue) {
+                a_rValue.uSize = static_cast<std::uint32_t>(a_strValue.size());
+                if (a_strValue.size() <= s_uInlineSize) {
+                    std::memcpy(a_rValue.acInline, a_strValue.data(), a_strValue.size());
+                }
+                else {
+                    a_rValue.uOffset = static_cast<std::uint32_t>(m_vecPool.size());
+                    m_vecPool.insert(m_vecPool.end(), a_strValue.begin(), a_strValue.end());
+                }
+            }
+
+            void CompactTree::to_ptree(boost::property_tree::ptree & a_rTree) const {
+                a_rTree.clear();
+                build_ptree(0, a_rTree);
+            }
+
+            boost::property_tree::ptree CompactTree::to_ptree() const {
+                boost::property_tree::ptree tree{};
+                build_ptree(0, tree);
+                return tree;
+            }
+
+            void CompactTree::build_ptree(index_t a_uNode, boost::property_tree::ptree & a_rTree) const {
+                a_rTree.data().assign(value(a_uNode));
+                Node const& node{ m_vecNodes[a_uNode] };
+                for (index_t uChild = node.uFirstChild; uChild < node.uFirstChild + node.uChildrenCount; ++uChild) {
+                    a_rTree.push_back(boost::property_tree::ptree::value_type{ std::string{ key(uChild) }, boost::property_tree::ptree{} });
+                    build_ptree(uChild, a_rTree.back().second);
+                }
+            }
+
+            CompactTree::index_t CompactTree::find_child(index_t a_uNode, std::string_view a_strKey) const {
+                Node const& node{ m_vecNodes[a_uNode] };
+                for (index_t uChild = node.uFirstChild; uChild < node.uFirstChild + node.uChildrenCount; ++uChild) {
+                    if (key(uChild) == a_strKey) {
+                        return uChild;
+                    }
+                }
+                return npos;
+            }
+
+            CompactTree::index_t CompactTree::find(std::string_view a_strPath, index_t a_uFrom) const {
+                index_t uNode{ a_uFrom };
+                while (npos != uNode && !a_strPath.empty()) {
+                    auto const uSeparator = a_strPath.find('.');
+                    uNode = find_child(uNode, a_strPath.substr(0, uSeparator));
+                    a_strPath = std::string_view::npos == uSeparator ? std::string_view{} : a_strPath.substr(uSeparator + 1);
+                }
+                return uNode;
+            }
+
+            std::string_view CompactTree::key(index_t a_uNode) const {
+                Key const& key{ m_vecKeys[m_vecNodes[a_uNode].uKey] };
+                if (key.pInterned) {
+                    return std::string_view{ key.pInterned, key.uSize };
+                }
+                return std::string_view{ m_vecKeyPool.data() + key.uOffset, key.uSize };
+            }
+
+            std::string_view CompactTree::value(index_t a_uNode) const {
+                Value const& value{ m_vecNodes[a_uNode].value };
+                if (value.uSize <= s_uInlineSize) {
+                    return std::string_view{ value.acInline, value.uSize };
+                }
+                return std::string_view{ m_vecPool.data() + value.uOffset, value.uSize };
+            }
+
+            std::size_t CompactTree::memory_usage() const {
+                // The interned keys themselves are shared with the registry: they are not counted
+                return m_vecNodes.capacity() * sizeof(Node) + m_vecPool.capacity()
+                     + m_vecKeys.capacity() * sizeof(Key) + m_vecKeyPool.capacity();
+            }
+
+            void CompactTree::swap(CompactTree & a_Other) noexcept {
+                m_vecNodes.swap(a_Other.m_vecNodes);
+                m_vecPool.swap(a_Other.m_vecPool);
+                m_vecKeys.swap(a_Other.m_vecKeys);
+                m_vecKeyPool.swap(a_Other.m_vecKeyPool);
+            }
+
+            bool CompactTree::operator==(CompactTree const& a_Other) const {
+                if (m_vecNodes.size() != a_Other.m_vecNodes.size()) {
+                    return false;
+                }
+                for (index_t uNode = 0; uNode < m_vecNodes.size(); ++uNode) {
+                    Node const& node{ m_vecNodes[uNode] };
+                    Node const& other{ a_Other.m_vecNodes[uNode] };
+                    // The key indexes depend on the order of the keys in each document: the keys themselves are compared
+                    if (node.uFirstChild != other.uFirstChild || node.uChildrenCount != other.uChildrenCount
+                        || key(uNode) != a_Other.key(uNode) || value(uNode) != a_Other.value(uNode)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        }
+    }
+}
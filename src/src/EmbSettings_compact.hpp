@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../include/EmbSettings.hpp"
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace emb {
+    namespace settings {
+        namespace internal {
+
+            /**
+             * @brief Compact read-only document model, equivalent to a boost::property_tree::ptree
+             * @details The nodes are stored contiguously in one arena and link their children by index: the children
+             *          of a node are consecutive, so that a node only stores the index of the first one and their count.
+             *          Each key is stored once per document: the registry keys reuse the strings of the global intern table,
+             *          the other ones are kept in a key pool of the document (unloading files never grows the global table).
+             *          The values of up to 12 characters are stored in the node itself, the longer ones in a single character pool.
+             *          A 100k-node document costs a few MB in a handful of allocations instead of ~20 MB scattered
+             *          in several allocations per node.
+             *          It does not replace the trees of the loaded files, which stay boost::property_tree::ptree: it only keeps
+             *          the content of the files unloaded to meet the memory budget.
+             */
+            class CompactTree {
+            public:
+                using index_t = std::uint32_t;
+                static constexpr index_t npos{ static_cast<index_t>(-1) };
+
+                CompactTree();
+                explicit CompactTree(boost::property_tree::ptree const& a_Tree);
+
+                /**
+                 * @brief Replace the content of the document by the content of a tree
+                 * @param a_Tree        Tree to copy
+                 */
+                void assign(boost::property_tree::ptree const& a_Tree);
+                /**
+                 * @brief Build the tree equivalent to the document
+                 * @param a_rTree       Tree receiving the content, cleared beforehand
+                 */
+                void to_ptree(boost::property_tree::ptree & a_rTree) const;
+                boost::property_tree::ptree to_ptree() const;
+
+                /**
+                 * @brief Index of the root node, whose key is empty
+                 */
+                index_t root() const { return 0; }
+                /**
+                 * @brief Find a node by its path
+                 * @param a_strPath     Keys of the nodes from the root, separated by '.'
+                 * @param a_uFrom       Node the path starts from
+                 * @return index_t      Index of the first node found, or npos
+                 */
+                index_t find(std::string_view a_strPath, index_t a_uFrom = 0) const;
+                /**
+                 * @brief Find a direct child of a node by its key
+                 * @param a_uNode       Node whose children are searched
+                 * @param a_strKey      Key of the child
+                 * @return index_t      Index of the first child found, or npos
+                 */
+                index_t find_child(index_t a_uNode, std::string_view a_strKey) const;
+
+                std::string_view key(index_t a_uNode) const;
+                std::string_view value(index_t a_uNode) const;
+                /**
+                 * @brief Index of the first child of a node, the other ones follow
+                 */
+                index_t first_child(index_t a_uNode) const { return m_vecNodes[a_uNode].uFirstChild; }
+                index_t children_count(index_t a_uNode) const { return m_vecNodes[a_uNode].uChildrenCount; }
+
+                std::size_t size() const { return m_vecNodes.size(); }
+                /**
+                 * @brief Approximate number of bytes allocated by the document
+                 */
+                std::size_t memory_usage() const;
+
+                void swap(CompactTree & a_Other) noexcept;
+
+                bool operator==(CompactTree const& a_Other) const;
+                bool operator!=(CompactTree const& a_Other) const { return !(*this == a_Other); }
+
+            private:
+                static constexpr std::uint32_t s_uInlineSize{ 12 };
+
+                /**
+                 * @brief Value of a node: inline when short enough, in the character pool otherwise
+                 */
+                struct Value {
+                    std::uint32_t uSize{ 0 };
+                    union {
+                        char acInline[s_uInlineSize];
+                        std::uint32_t uOffset;
+                    };
+                };
+
+                /**
+                 * @brief Key used by the document: shared with the intern table, or stored in the key pool
+                 */
+                struct Key {
+                    char const* pInterned{ nullptr };   ///< Interned key, nullptr for a key stored in m_vecKeyPool
+                    std::uint32_t uOffset{ 0 };         ///< Offset of the key in m_vecKeyPool
+                    std::uint32_t uSize{ 0 };
+                };
+
+                struct Node {
+                    index_t uKey{ 0 };              ///< Index of the key in m_vecKeys
+                    index_t uFirstChild{ npos };
+                    index_t uChildrenCount{ 0 };
+                    Value value{};
+                };
+
+                using KeyIndexes = std::unordered_map<std::string_view, index_t>;
+
+                index_t add_key(std::string const& a_strKey, KeyIndexes & a_rmapKeyIndexes);
+                void store_value(Value & a_rValue, std::string const& a_strValue);
+                void append_children(index_t a_uNode, boost::property_tree::ptree const& a_Tree, KeyIndexes & a_rmapKeyIndexes);
+                void build_ptree(index_t a_uNode, boost::property_tree::ptree & a_rTree) const;
+
+                std::vector<Node> m_vecNodes{};
+                std::vector<char> m_vecPool{};
+                std::vector<Key> m_vecKeys{};       ///< Distinct keys used by the document
+                std::vector<char> m_vecKeyPool{};   ///< Characters of the keys that are not interned
+            };
+
+        }
+    }
+}
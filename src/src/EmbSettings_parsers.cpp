@@ -0,0 +1,60 @@
+#include "EmbSettings_parsers.hpp"
+#define BOOST_BIND_GLOBAL_PLACEHOLDERS // Avoid warning
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+
+#ifndef __cpp_exceptions
+#error "EmbSettings_parsers.cpp must be built with exceptions enabled"
+#endif
+
+namespace {
+
+    /**
+     * @brief Key comparison local to this translation unit
+     * @details Gives a tree type of its own: its templates, built here with exceptions, cannot be merged by the linker
+     *          with the boost::property_tree::ptree ones of the rest of the library, built without.
+     */
+    struct ParserKeyCompare : std::less<std::string> {};
+
+    using ParserTree = boost::property_tree::basic_ptree<std::string, std::string, ParserKeyCompare>;
+
+    void flatten_tree(std::string const& a_strKey, ParserTree & a_rTree, std::vector<emb::settings::internal::ParsedNode> & a_rvecNodes) {
+        a_rvecNodes.push_back(emb::settings::internal::ParsedNode{ a_strKey, std::move(a_rTree.data()), a_rTree.size() });
+        for (auto & child : a_rTree) {
+            flatten_tree(child.first, child.second, a_rvecNodes);
+        }
+    }
+
+}
+
+namespace emb {
+    namespace settings {
+        namespace internal {
+
+            bool parse_tree(FileType a_eFileType, std::istream & a_streamInput, std::vector<ParsedNode> & a_rvecNodes) {
+                try {
+                    ParserTree tree{};
+                    switch (a_eFileType) {
+                    case FileType::XML:
+                        boost::property_tree::read_xml(a_streamInput, tree, boost::property_tree::xml_parser::trim_whitespace);
+                        break;
+                    case FileType::JSON:
+                        boost::property_tree::read_json(a_streamInput, tree);
+                        break;
+                    case FileType::INI:
+                        boost::property_tree::read_ini(a_streamInput, tree);
+                        break;
+                    }
+                    a_rvecNodes.clear();
+                    flatten_tree(std::string{}, tree, a_rvecNodes);
+                }
+                catch (...) {
+                    return false;
+                }
+                return true;
+            }
+
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../include/EmbSettings.hpp"
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace emb {
+    namespace settings {
+        namespace internal {
+
+            /**
+             * @brief Node of a parsed settings file
+             */
+            struct ParsedNode {
+                std::string strKey{};       ///< Key of the node, empty for the root
+                std::string strData{};      ///< Data of the node
+                std::size_t uChildren{0};   ///< Number of direct children, stored right after the node (depth-first)
+            };
+
+            /**
+             * @brief Parse the content of a settings file
+             * @details The boost parsers report errors by exceptions (the XML one cannot even be built without them):
+             *          they live in their own translation unit, always built with exceptions, and the errors never leave it.
+             *          This translation unit parses into its own tree type and gives back plain nodes, so that the
+             *          boost::property_tree::ptree templates shared with the library are never instantiated with exceptions.
+             * @param a_eFileType       Type of the file
+             * @param a_streamInput     Content of the file
+             * @param a_rvecNodes       Nodes of the content, depth-first, starting with the root
+             * @return true             The content has been parsed
+             * @return false            The content is malformed, \c a_rvecNodes is left in an unspecified state
+             */
+            bool parse_tree(FileType a_eFileType, std::istream & a_streamInput, std::vector<ParsedNode> & a_rvecNodes);
+
+        }
+    }
+}
@@ -2,9 +2,36 @@
 #include "catch.hpp"
 
 #include "../src/include/EmbSettings.hpp"
+#include "../src/src/EmbSettings_compact.hpp"
+#include "../src/src/filesystem.hpp"
+#include <fstream>
+#include <thread>
 
 EMBSETTINGS_FILE(File, JSON, "@{dir}/File.xml", 1, nullptr)
 EMBSETTINGS_SCALAR(Scalar, int, File, "file.key", 1)
+EMBSETTINGS_SCALAR(OtherScalar, int, File, "file.other", 2)
+EMBSETTINGS_HOT_SCALAR(HotScalar, double, File, "file.hot", 0.5)
+EMBSETTINGS_SCALAR(PlainStringScalar, std::string, File, "file.plain", "plain")
+enum class Mode { Off, On = 42 };
+EMBSETTINGS_SCALAR(DoubleScalar, double, File, "file.double", 0.1)
+EMBSETTINGS_SCALAR(EnumScalar, Mode, File, "file.enum", Mode::Off)
+EMBSETTINGS_VECTOR(PackedVector, double, File, "file.packed", nullptr, Packed)
+EMBSETTINGS_FILE(SidecarFile, XML, "SidecarFile.xml")
+EMBSETTINGS_VECTOR(SidecarVector, float, SidecarFile, "file.sidecar", nullptr, Sidecar)
+EMBSETTINGS_VECTOR(NodesVector, int, SidecarFile, "file.nodes", nullptr)
+EMBSETTINGS_MAP(RoutesMap, int, SidecarFile, "file.routes", nullptr)
+EMBSETTINGS_SCALAR(StringScalar, std::string, SidecarFile, "file.string", "default")
+EMBSETTINGS_VECTOR(StringVector, std::string, SidecarFile, "file.strings", nullptr)
+struct Pid { double kp; double ki; double kd; std::string name; };
+EMBSETTINGS_STRUCT_FIELDS(Pid, kp, ki, kd, name)
+EMBSETTINGS_STRUCT(PidStruct, Pid, SidecarFile, "file.pid", (Pid{1., 0.5, 0., "pid"}))
+struct Device { int id; std::string address; double gain; bool enabled; };
+EMBSETTINGS_STRUCT_FIELDS(Device, id, address, gain, enabled)
+EMBSETTINGS_TABLE(DeviceTable, Device, SidecarFile, "file.devices", id)
+EMBSETTINGS_FILE(BudgetFile, JSON, "BudgetFile.json")
+EMBSETTINGS_SCALAR(BudgetScalar, std::string, BudgetFile, "budget.value", "default")
+EMBSETTINGS_FILE(WatchedFile, JSON, "WatchedFile.json")
+EMBSETTINGS_SCALAR(WatchedScalar, std::string, WatchedFile, "watched.value", "default")
 
 TEST_CASE("SettingsFile_static_properties") {
     SECTION("File name") {
@@ -24,6 +51,18 @@ TEST_CASE("SettingsFile_static_properties") {
     }
 }
 
+TEST_CASE("SettingsFile_malformed_content") {
+    SECTION("Defaults used for a malformed file") {
+        StringScalar::write("before malformed content");
+        std::stringstream malformed{ "<settings><file><string>unclosed" };
+        SidecarFile::restore_from(malformed);
+        REQUIRE("default" == StringScalar::read());
+        StringScalar::write("after malformed content");
+        REQUIRE("after malformed content" == StringScalar::read());
+        StringScalar::reset();
+    }
+}
+
 TEST_CASE("SettingElement_Scalar_static_properties") {
     SECTION("Element name") {
         REQUIRE(std::string("Scalar") == Scalar::Name);
@@ -79,3 +118,772 @@ TEST_CASE("SettingElement_transactions") {
         REQUIRE(5678 == Scalar::read());
     }
 }
+
+TEST_CASE("SettingElement_change_notifications") {
+    SECTION("Notification on transaction commit") {
+        // Subscriptions outlive the test case
+        static int iOld{0}, iNew{0}, iOtherCount{0};
+        Scalar::write(10);
+        Scalar::subscribe([](int const& a_iOld, int const& a_iNew) { iOld = a_iOld; iNew = a_iNew; });
+        OtherScalar::subscribe([](int const&, int const&) { ++iOtherCount; });
+        File::begin();
+        Scalar::write(20);
+        REQUIRE(0 == iNew);
+        File::commit();
+        REQUIRE(10 == iOld);
+        REQUIRE(20 == iNew);
+        REQUIRE(0 == iOtherCount);
+    }
+    SECTION("Notification on restore") {
+        static std::string strOld{}, strNew{};
+        static int iCount{0};
+        StringScalar::write("backed up");
+        std::stringstream backup{};
+        REQUIRE(SidecarFile::backup_to(backup));
+        StringScalar::write("overwritten");
+        StringScalar::subscribe([](std::string const& a_strOld, std::string const& a_strNew) { strOld = a_strOld; strNew = a_strNew; ++iCount; });
+        REQUIRE(SidecarFile::restore_from(backup));
+        REQUIRE(1 == iCount);
+        REQUIRE("overwritten" == strOld);
+        REQUIRE("backed up" == strNew);
+        REQUIRE("backed up" == StringScalar::read());
+        StringScalar::reset();
+    }
+    SECTION("No notification on transaction abort") {
+        static int iCount{0};
+        OtherScalar::subscribe([](int const&, int const&) { ++iCount; });
+        File::begin();
+        OtherScalar::write(70);
+        File::abort();
+        REQUIRE(0 == iCount);
+    }
+    SECTION("Notification of vectors and maps on restore") {
+        static std::vector<int> vecOld{}, vecNew{};
+        static std::map<std::string, int> mapOld{}, mapNew{};
+        NodesVector::write({1, 2});
+        RoutesMap::write({{"eth0", 1}});
+        std::stringstream backup{};
+        REQUIRE(SidecarFile::backup_to(backup));
+        NodesVector::write({1, 2, 3});
+        RoutesMap::write({{"eth0", 2}});
+        NodesVector::subscribe([](std::vector<int> const& a_vecOld, std::vector<int> const& a_vecNew) { vecOld = a_vecOld; vecNew = a_vecNew; });
+        RoutesMap::subscribe([](std::map<std::string, int> const& a_mapOld, std::map<std::string, int> const& a_mapNew) { mapOld = a_mapOld; mapNew = a_mapNew; });
+        REQUIRE(SidecarFile::restore_from(backup));
+        REQUIRE(std::vector<int>{1, 2, 3} == vecOld);
+        REQUIRE(std::vector<int>{1, 2} == vecNew);
+        REQUIRE(std::map<std::string, int>{{"eth0", 2}} == mapOld);
+        REQUIRE(std::map<std::string, int>{{"eth0", 1}} == mapNew);
+        NodesVector::reset();
+        RoutesMap::reset();
+    }
+    SECTION("Notification on external change") {
+        static std::string strOld{}, strNew{};
+        StringScalar::write("before external change");
+        StringScalar::subscribe([](std::string const& a_strOld, std::string const& a_strNew) { strOld = a_strOld; strNew = a_strNew; });
+        REQUIRE(emb::settings::start_file_watcher(std::chrono::milliseconds{20}));
+        std::stringstream content{};
+        REQUIRE(SidecarFile::backup_to(content));
+        std::string strContent{ content.str() };
+        strContent.replace(strContent.find("before"), std::string{"before"}.size(), "after");
+        std::ofstream{ "SidecarFile.xml" } << strContent;
+        for(int i = 0; i < 100 && strNew.empty(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+        emb::settings::stop_file_watcher();
+        REQUIRE("before external change" == strOld);
+        REQUIRE("after external change" == strNew);
+        StringScalar::reset();
+    }
+    SECTION("Notification of an element subscribed after a first notification") {
+        static std::vector<std::string> vecNew{};
+        static int iCount{0};
+        StringVector::write({"backup"});
+        std::stringstream backup{};
+        REQUIRE(SidecarFile::backup_to(backup));
+        StringVector::write({"overwrite"});
+        StringScalar::write("overwritten");
+        // The key index of the file is built without StringVector
+        REQUIRE(SidecarFile::restore_from(backup));
+        StringVector::subscribe([](std::vector<std::string> const&, std::vector<std::string> const& a_vecNew) { vecNew = a_vecNew; ++iCount; });
+        StringVector::write({"overwrite"});
+        backup.clear();
+        backup.seekg(0);
+        REQUIRE(SidecarFile::restore_from(backup));
+        REQUIRE(1 == iCount);
+        REQUIRE(std::vector<std::string>{"backup"} == vecNew);
+        StringVector::reset();
+        StringScalar::reset();
+    }
+}
+
+TEST_CASE("SettingElement_linked_variables") {
+    SECTION("AutoRefresh variable") {
+        static int iVariable{0};
+        Scalar::write(30);
+        Scalar::link(iVariable, emb::settings::LinkMode::AutoRefresh);
+        REQUIRE(30 == iVariable);
+        Scalar::write(31);
+        REQUIRE(31 == iVariable);
+        Scalar::reset();
+        REQUIRE(Scalar::Default == iVariable);
+    }
+    SECTION("Linked variable refreshed on commit") {
+        static emb::settings::Linked<int> linked{};
+        OtherScalar::write(40);
+        OtherScalar::link(linked);
+        REQUIRE(40 == linked.load());
+        File::begin();
+        OtherScalar::write(41);
+        REQUIRE(40 == linked.load());
+        File::commit();
+        REQUIRE(41 == linked);
+    }
+}
+
+TEST_CASE("SettingElement_hot_scalar") {
+    SECTION("Mirror refreshed on write, reset and commit") {
+        REQUIRE(0.5 == HotScalar::read());
+        HotScalar::write(1.5);
+        REQUIRE(1.5 == HotScalar::read());
+        File::begin();
+        HotScalar::write(2.5);
+        REQUIRE(1.5 == HotScalar::read());
+        File::commit();
+        REQUIRE(2.5 == HotScalar::read());
+        HotScalar::reset();
+        REQUIRE(HotScalar::Default == HotScalar::read());
+    }
+    SECTION("Non-hot string scalar read through the tree") {
+        REQUIRE("plain" == PlainStringScalar::read());
+        PlainStringScalar::write("written");
+        REQUIRE("written" == PlainStringScalar::read());
+        PlainStringScalar::reset();
+        REQUIRE(PlainStringScalar::is_default());
+    }
+}
+
+TEST_CASE("SettingElement_value_conversions") {
+    SECTION("Floating point round trip") {
+        DoubleScalar::write(0.1 + 0.2);
+        REQUIRE(0.1 + 0.2 == DoubleScalar::read());
+        DoubleScalar::write(-1.5e-300);
+        REQUIRE(-1.5e-300 == DoubleScalar::read());
+    }
+    SECTION("Enumeration written as its underlying type") {
+        EnumScalar::write(Mode::On);
+        REQUIRE(Mode::On == EnumScalar::read());
+        REQUIRE("42" == emb::settings::get_element(File::Name, EnumScalar::Name)->read_str_m());
+    }
+}
+
+TEST_CASE("SettingElement_packed_vector") {
+    SECTION("Values stored in a single node") {
+        std::vector<double> vecValues(1000);
+        for(std::size_t i = 0; i < vecValues.size(); ++i) {
+            vecValues[i] = static_cast<double>(i) / 7.;
+        }
+        PackedVector::write(vecValues);
+        REQUIRE(vecValues == PackedVector::read());
+        PackedVector::add(-2.5);
+        vecValues.push_back(-2.5);
+        REQUIRE(vecValues == PackedVector::read());
+        PackedVector::reset();
+        REQUIRE(PackedVector::is_default());
+        REQUIRE(PackedVector::read().empty());
+    }
+    SECTION("Values separated by any whitespace") {
+        std::string strPacked{};
+        std::vector<int> vecValues{};
+        for(int i = 0; i < 100; ++i) {
+            strPacked += std::to_string(i) + " \t\n\v\f\r"[i % 6];
+            vecValues.push_back(i);
+        }
+        REQUIRE(100 == emb::settings::internal::count_packed_separators(strPacked));
+        REQUIRE(vecValues == emb::settings::internal::parse_packed_vector<int>(strPacked));
+        std::string strAllBytes(512, '\0');
+        for(std::size_t i = 0; i < strAllBytes.size(); ++i) {
+            strAllBytes[i] = static_cast<char>(i);
+        }
+        REQUIRE(12 == emb::settings::internal::count_packed_separators(strAllBytes));
+    }
+}
+
+TEST_CASE("SettingElement_sidecar_vector") {
+    SECTION("Values stored in a mapped binary file") {
+        std::vector<float> vecValues(100000);
+        for(std::size_t i = 0; i < vecValues.size(); ++i) {
+            vecValues[i] = static_cast<float>(i) * 0.5f;
+        }
+        SidecarVector::write(vecValues);
+        auto const view = SidecarVector::view();
+        REQUIRE(vecValues.size() == view.size());
+        REQUIRE(std::equal(view.begin(), view.end(), vecValues.begin()));
+        SidecarFile::begin();
+        SidecarVector::write({1.f, 2.f});
+        REQUIRE(vecValues == SidecarVector::read());
+        SidecarFile::commit();
+        REQUIRE(std::vector<float>{1.f, 2.f} == SidecarVector::read());
+        // The previous view still sees the previous values
+        REQUIRE(vecValues.size() == view.size());
+        REQUIRE(0.5f == view[1]);
+        SidecarFile::begin();
+        SidecarVector::add(3.f);
+        SidecarFile::abort();
+        REQUIRE(std::vector<float>{1.f, 2.f} == SidecarVector::read());
+        SidecarVector::reset();
+        REQUIRE(SidecarVector::is_default());
+        REQUIRE(SidecarVector::view().empty());
+    }
+    SECTION("Values written and added in a transaction") {
+        SidecarFile::begin();
+        SidecarVector::write({1.f, 2.f});
+        SidecarVector::add(3.f);
+        SidecarVector::add(4.f);
+        REQUIRE(SidecarVector::read().empty());
+        SidecarFile::commit();
+        REQUIRE(std::vector<float>{1.f, 2.f, 3.f, 4.f} == SidecarVector::read());
+        SidecarFile::begin();
+        SidecarVector::add(5.f);
+        SidecarVector::add(6.f);
+        SidecarFile::commit();
+        REQUIRE(std::vector<float>{1.f, 2.f, 3.f, 4.f, 5.f, 6.f} == SidecarVector::read());
+        SidecarVector::reset();
+    }
+    SECTION("Notification on transaction commit and restore") {
+        static std::vector<float> vecOld{}, vecNew{};
+        static int iCount{0};
+        SidecarVector::write({1.f});
+        SidecarVector::subscribe([](std::vector<float> const& a_vecOld, std::vector<float> const& a_vecNew) {
+            vecOld = a_vecOld;
+            vecNew = a_vecNew;
+            ++iCount;
+        });
+        SidecarFile::begin();
+        SidecarVector::add(2.f);
+        SidecarFile::commit();
+        REQUIRE(1 == iCount);
+        REQUIRE(std::vector<float>{1.f} == vecOld);
+        REQUIRE(std::vector<float>{1.f, 2.f} == vecNew);
+        REQUIRE(SidecarFile::backup_to("sidecar_backup"));
+        SidecarFile::begin();
+        SidecarVector::write({3.f});
+        SidecarFile::commit();
+        REQUIRE(2 == iCount);
+        REQUIRE(SidecarFile::restore_from("sidecar_backup"));
+        REQUIRE(3 == iCount);
+        REQUIRE(std::vector<float>{3.f} == vecOld);
+        REQUIRE(std::vector<float>{1.f, 2.f} == vecNew);
+        REQUIRE(std::vector<float>{1.f, 2.f} == SidecarVector::read());
+        // Unchanged values are not notified
+        SidecarFile::begin();
+        SidecarVector::write({1.f, 2.f});
+        SidecarFile::commit();
+        REQUIRE(3 == iCount);
+        SidecarVector::reset();
+    }
+    SECTION("Sidecars of other settings files left alone by backup and restore") {
+        SidecarVector::write({1.f});
+        // Sidecar of a settings file named "SidecarFile.xml.old"
+        std::ofstream{ "SidecarFile.xml.old.SidecarVector.bin" } << "other";
+        REQUIRE(SidecarFile::backup_to("sidecar_other_backup"));
+        REQUIRE(std::ifstream{ "sidecar_other_backup/SidecarFile.xml.SidecarVector.bin" }.is_open());
+        REQUIRE_FALSE(std::ifstream{ "sidecar_other_backup/SidecarFile.xml.old.SidecarVector.bin" }.is_open());
+        REQUIRE(SidecarFile::restore_from("sidecar_other_backup"));
+        REQUIRE(std::ifstream{ "SidecarFile.xml.old.SidecarVector.bin" }.is_open());
+        REQUIRE(std::vector<float>{1.f} == SidecarVector::read());
+        SidecarVector::reset();
+    }
+}
+
+TEST_CASE("SettingElement_vector_in_place") {
+    SECTION("Nodes modified in place") {
+        NodesVector::write({1, 2, 3});
+        REQUIRE(3 == NodesVector::size());
+        REQUIRE(NodesVector::set_at(1, 20));
+        REQUIRE(NodesVector::insert_at(0, 0));
+        REQUIRE(NodesVector::insert_at(4, 4));
+        REQUIRE(NodesVector::erase_at(3));
+        REQUIRE(std::vector<int>{0, 1, 20, 4} == NodesVector::read());
+        REQUIRE(20 == NodesVector::at(2));
+        REQUIRE_FALSE(NodesVector::at(4));
+        REQUIRE_FALSE(NodesVector::set_at(4, 5));
+        REQUIRE_FALSE(NodesVector::erase_at(4));
+        NodesVector::reset();
+        REQUIRE(0 == NodesVector::size());
+        REQUIRE(NodesVector::insert_at(0, 7));
+        REQUIRE(std::vector<int>{7} == NodesVector::read());
+        NodesVector::reset();
+    }
+    SECTION("Other storages read, modified and written back") {
+        SidecarVector::write({1.f, 2.f});
+        REQUIRE(SidecarVector::insert_at(1, 1.5f));
+        REQUIRE(SidecarVector::erase_at(0));
+        REQUIRE(std::vector<float>{1.5f, 2.f} == SidecarVector::read());
+        REQUIRE(2 == SidecarVector::size());
+        SidecarVector::reset();
+    }
+}
+
+TEST_CASE("SettingElement_map_single_key") {
+    SECTION("Values accessed by key") {
+        RoutesMap::write({{"eth0", 1}, {"eth1", 2}, {"wlan0", 3}});
+        REQUIRE(3 == RoutesMap::size());
+        REQUIRE(2 == RoutesMap::get("eth1"));
+        REQUIRE_FALSE(RoutesMap::get("eth2"));
+        REQUIRE(RoutesMap::contains("wlan0"));
+        REQUIRE(RoutesMap::erase("eth1"));
+        REQUIRE_FALSE(RoutesMap::erase("eth1"));
+        REQUIRE_FALSE(RoutesMap::contains("eth1"));
+        REQUIRE(2 == RoutesMap::size());
+        REQUIRE(std::map<std::string, int>{{"eth0", 1}, {"wlan0", 3}} == RoutesMap::read());
+        RoutesMap::reset();
+        REQUIRE(0 == RoutesMap::size());
+    }
+}
+
+TEST_CASE("SettingElement_read_guard_views") {
+    SECTION("Values borrowed from the locked tree") {
+        StringScalar::reset();
+        StringVector::write({"a", "bb", "ccc"});
+        RoutesMap::write({{"eth0", 1}, {"eth1", 2}});
+        {
+            auto const guard = SidecarFile::view();
+            REQUIRE(guard);
+            REQUIRE("default" == StringScalar::view(guard));
+            std::string strConcat{};
+            for(auto const& strValue : StringVector::view(guard)) {
+                strConcat += strValue;
+            }
+            REQUIRE("abbccc" == strConcat);
+            int iSum{0};
+            for(auto const& [strKey, iValue] : RoutesMap::view(guard)) {
+                REQUIRE(strKey.substr(0, 3) == "eth");
+                iSum += iValue;
+            }
+            REQUIRE(3 == iSum);
+            REQUIRE(2 == RoutesMap::view(guard).size());
+        }
+        StringScalar::write("written");
+        REQUIRE("written" == StringScalar::view(SidecarFile::view()));
+        StringScalar::reset();
+        StringVector::reset();
+        RoutesMap::reset();
+    }
+}
+
+TEST_CASE("SettingElement_read_into") {
+    SECTION("Existing storage reused") {
+        StringVector::write({"first value", "second value"});
+        std::vector<std::string> vecValues{"previous long value to reuse", "x", "removed"};
+        auto const* pFirst = vecValues[0].data();
+        StringVector::read_into(vecValues);
+        REQUIRE(std::vector<std::string>{"first value", "second value"} == vecValues);
+        REQUIRE(pFirst == vecValues[0].data());
+        RoutesMap::write({{"eth0", 1}, {"eth1", 2}});
+        std::map<std::string, int> mapValues{{"eth1", 0}, {"lo", 0}};
+        auto const* pNode = &mapValues["eth1"];
+        RoutesMap::read_into(mapValues);
+        REQUIRE(std::map<std::string, int>{{"eth0", 1}, {"eth1", 2}} == mapValues);
+        REQUIRE(pNode == &mapValues["eth1"]);
+        StringVector::reset();
+        RoutesMap::reset();
+        StringVector::read_into(vecValues);
+        RoutesMap::read_into(mapValues);
+        REQUIRE(vecValues.empty());
+        REQUIRE(mapValues.empty());
+        PackedVector::write({1.5, 2.5});
+        std::vector<double> vecPacked{};
+        PackedVector::read_into(vecPacked);
+        REQUIRE(std::vector<double>{1.5, 2.5} == vecPacked);
+        PackedVector::reset();
+    }
+}
+
+TEST_CASE("SettingElement_move_writes") {
+    SECTION("Values moved into the tree") {
+        std::string strValue(64, 'm');
+        StringScalar::write(std::move(strValue));
+        REQUIRE(std::string(64, 'm') == StringScalar::read());
+        std::vector<std::string> vecValues{std::string(64, 'a'), std::string(64, 'b')};
+        StringVector::write(std::move(vecValues));
+        REQUIRE(std::vector<std::string>{std::string(64, 'a'), std::string(64, 'b')} == StringVector::read());
+        std::vector<int> vecInts{1, 2, 3};
+        NodesVector::write(vecInts);
+        NodesVector::write(std::move(vecInts));
+        REQUIRE(std::vector<int>{1, 2, 3} == NodesVector::read());
+        RoutesMap::write(std::map<std::string, int>{{"eth0", 1}, {"eth1", 2}});
+        REQUIRE(2 == RoutesMap::get("eth1"));
+        StringScalar::reset();
+        StringVector::reset();
+        NodesVector::reset();
+        RoutesMap::reset();
+    }
+}
+
+TEST_CASE("SettingElement_struct") {
+    SECTION("Fields read and written in one pass") {
+        REQUIRE(PidStruct::is_default());
+        REQUIRE(0.5 == PidStruct::read().ki);
+        PidStruct::write(Pid{2., 0.25, 0.125, "speed"});
+        auto const stPid = PidStruct::read();
+        REQUIRE(2. == stPid.kp);
+        REQUIRE(0.25 == stPid.ki);
+        REQUIRE(0.125 == stPid.kd);
+        REQUIRE("speed" == stPid.name);
+        REQUIRE_FALSE(PidStruct::is_default());
+        PidStruct::reset();
+        REQUIRE(PidStruct::is_default());
+        REQUIRE("pid" == PidStruct::read().name);
+    }
+}
+
+TEST_CASE("SettingElement_table") {
+    SECTION("Columns, queries and primary key index") {
+        REQUIRE(DeviceTable::is_default());
+        REQUIRE(DeviceTable::read().empty());
+        DeviceTable::Type table{};
+        REQUIRE(table.insert(Device{3, "10.0.0.3", 1.5, true}));
+        REQUIRE(table.insert(Device{7, "a;b\\c", 2.5, false}));
+        REQUIRE(table.insert(Device{9, "10.0.0.9", 4., true}));
+        REQUIRE_FALSE(table.insert(Device{7, "duplicate", 0., true}));
+        REQUIRE(3 == table.size());
+        REQUIRE(8. == table.sum(&Device::gain));
+        REQUIRE(2 == table.count_if(&Device::enabled, [](bool b) { return b; }));
+        REQUIRE(std::vector<std::size_t>{1, 2} == table.filter(&Device::gain, [](double d) { return d > 2.; }));
+        REQUIRE(std::vector<int>{3, 7, 9} == table.column(&Device::id));
+        REQUIRE(2 == table.find(9));
+        REQUIRE(std::vector<std::uint8_t>{1, 0, 1} == table.column(&Device::enabled));
+        REQUIRE(table.erase(3));
+        REQUIRE_FALSE(table.find(3));
+        REQUIRE(0 == table.find(9));
+        REQUIRE(1 == table.find(7));
+        REQUIRE(std::vector<int>{9, 7} == table.column(&Device::id));
+        REQUIRE(table.update(Device{9, "10.0.0.10", 4., false}));
+        REQUIRE("10.0.0.10" == table.get(9)->address);
+        DeviceTable::write(table);
+        auto const tableRead = DeviceTable::read();
+        REQUIRE(table == tableRead);
+        REQUIRE("a;b\\c" == tableRead.get(7)->address);
+        REQUIRE_FALSE(DeviceTable::is_default());
+        DeviceTable::reset();
+        REQUIRE(DeviceTable::is_default());
+    }
+    SECTION("Moved-from tables left empty and usable") {
+        DeviceTable::Type table{};
+        REQUIRE(table.insert(Device{1, "10.0.0.1", 1., true}));
+        DeviceTable::Type moved{ std::move(table) };
+        REQUIRE(1 == moved.size());
+        REQUIRE(table.empty());
+        REQUIRE(table.insert(Device{2, "10.0.0.2", 2., true}));
+        REQUIRE(std::vector<int>{2} == table.column(&Device::id));
+        moved = std::move(table);
+        REQUIRE(2 == moved.get(2)->id);
+        REQUIRE_FALSE(moved.find(1));
+        REQUIRE(table.empty());
+        REQUIRE(table.insert(Device{3, "10.0.0.3", 3., false}));
+        REQUIRE(0 == table.find(3));
+    }
+}
+
+TEST_CASE("CompactTree_round_trip") {
+    SECTION("Lookups and conversion from and to a ptree") {
+        boost::property_tree::ptree tree{};
+        tree.put("file.key", 3);
+        tree.put("file.name", "a value longer than the inline storage");
+        tree.add("file.list.item", "a");
+        tree.add("file.list.item", "b");
+        emb::settings::internal::CompactTree const compact{ tree };
+        REQUIRE(7 == compact.size());
+        REQUIRE("3" == compact.value(compact.find("file.key")));
+        REQUIRE("a value longer than the inline storage" == compact.value(compact.find("file.name")));
+        auto const uList = compact.find("file.list");
+        REQUIRE(2 == compact.children_count(uList));
+        REQUIRE("b" == compact.value(compact.first_child(uList) + 1));
+        REQUIRE(emb::settings::internal::CompactTree::npos == compact.find("file.missing"));
+        REQUIRE(tree == compact.to_ptree());
+        auto const copy = compact;
+        REQUIRE(compact == copy);
+        REQUIRE("item" == copy.key(copy.find("file.list.item")));
+    }
+}
+
+TEST_CASE("Interned_names") {
+    SECTION("Names shared by the registry, the elements and the compact trees") {
+        using emb::settings::internal::intern;
+        auto const pElement = emb::settings::get_element("File", "Scalar");
+        REQUIRE("File" == pElement->get_file_m());
+        REQUIRE("file.key" == pElement->get_key_m());
+        REQUIRE(emb::settings::get_file("File")->get_name_m().data() == pElement->get_file_m().data());
+        REQUIRE(emb::settings::get_element("File", "OtherScalar")->get_file_m().data() == pElement->get_file_m().data());
+        REQUIRE(intern(std::string{"file.key"}).data() == pElement->get_key_m().data());
+        REQUIRE(nullptr == emb::settings::internal::find_interned("never interned").data());
+        boost::property_tree::ptree tree{};
+        tree.put("File", 1);
+        tree.put("document_only_key", 2);
+        emb::settings::internal::CompactTree const compact{ tree };
+        REQUIRE(pElement->get_file_m().data() == compact.key(compact.find("File")).data());
+        // The other keys are kept by the document only
+        REQUIRE("2" == compact.value(compact.find("document_only_key")));
+        REQUIRE(nullptr == emb::settings::internal::find_interned("document_only_key").data());
+    }
+    SECTION("Keys and file types kept by the registry") {
+        REQUIRE("file.key" == emb::settings::internal::get_element_key("File", "Scalar"));
+        REQUIRE(emb::settings::internal::intern("file.key").data() == emb::settings::internal::get_element_key("File", "Scalar").data());
+        REQUIRE(emb::settings::internal::get_element_key("File", "Unknown").empty());
+        REQUIRE(emb::settings::FileType::JSON == emb::settings::internal::get_file_type("File"));
+        REQUIRE(emb::settings::FileType::XML == emb::settings::internal::get_file_type("SidecarFile"));
+        REQUIRE(emb::settings::FileType::JSON == emb::settings::internal::get_file_type("BudgetFile"));
+    }
+}
+
+TEST_CASE("Memory_budget") {
+    SECTION("Least recently used files unloaded and read again") {
+        BudgetScalar::write("kept on disk");
+        REQUIRE(emb::settings::get_file_memory_usage("BudgetFile") > 0);
+        Scalar::read();
+        // Every file is over a 1-byte budget: the least recently used one is unloaded first
+        emb::settings::set_memory_budget(1);
+        REQUIRE(0 == emb::settings::get_file_memory_usage("BudgetFile"));
+        REQUIRE("kept on disk" == BudgetScalar::read());
+        emb::settings::set_memory_budget();
+        BudgetScalar::read();
+        REQUIRE(emb::settings::get_file_memory_usage("BudgetFile") > 0);
+        REQUIRE(0 == emb::settings::get_file_memory_usage("Unknown"));
+    }
+    SECTION("Least recently used file compacted, then restored without reading it") {
+        auto const budget_stats = [] {
+            auto const stStats = emb::settings::memory_stats();
+            return *std::find_if(stStats.vecFiles.begin(), stStats.vecFiles.end(),
+                [](emb::settings::FileMemoryStats const& a_stFile) { return "BudgetFile" == a_stFile.strFileName; });
+        };
+        auto const reloads = [] {
+            auto const vecStats = emb::settings::stats();
+            return std::find_if(vecStats.begin(), vecStats.end(),
+                [](emb::settings::FileStats const& a_stFile) { return "BudgetFile" == a_stFile.strFileName; })->uReloads;
+        };
+        BudgetScalar::write("compacted");
+        // Large enough for its compact copy to be smaller
+        {
+            auto pTree = emb::settings::internal::get_file_tree("BudgetFile", false);
+            for(int i = 0; i < 1000; ++i) {
+                pTree->put("filler.key" + std::to_string(i), i);
+            }
+        }
+        Scalar::read();
+        StringScalar::read();
+        WatchedScalar::read();
+        std::size_t uTotal{ 0 };
+        for(char const* szFile : { "File", "SidecarFile", "BudgetFile", "WatchedFile" }) {
+            uTotal += emb::settings::get_file_memory_usage(szFile);
+        }
+        auto const stLoaded = budget_stats();
+        auto const uReloads = reloads();
+        // Compacting the least recently used file is enough to meet the budget
+        emb::settings::set_memory_budget(uTotal - 1);
+        auto const stCompacted = budget_stats();
+        REQUIRE_FALSE(stCompacted.bLoaded);
+        REQUIRE(stCompacted.uCompactTreeBytes > 0);
+        REQUIRE(stCompacted.uTotalBytes < stLoaded.uTotalBytes);
+        emb::settings::set_memory_budget();
+        REQUIRE("compacted" == BudgetScalar::read());
+        REQUIRE(uReloads == reloads());
+        REQUIRE(budget_stats().bLoaded);
+        REQUIRE(0 == budget_stats().uCompactTreeBytes);
+        emb::settings::internal::get_file_tree("BudgetFile", false)->erase("filler");
+    }
+}
+
+TEST_CASE("Memory_stats") {
+    SECTION("Files and registry footprint") {
+        BudgetScalar::write("measured");
+        auto const stStats = emb::settings::memory_stats();
+        auto const itFile = std::find_if(stStats.vecFiles.begin(), stStats.vecFiles.end(),
+            [](emb::settings::FileMemoryStats const& a_stFile) { return "BudgetFile" == a_stFile.strFileName; });
+        REQUIRE(itFile != stStats.vecFiles.end());
+        REQUIRE(itFile->bLoaded);
+        REQUIRE(2 == itFile->uNodesCount);
+        REQUIRE(std::string{"budgetvalue"}.size() == itFile->uKeysBytes);
+        REQUIRE(std::string{"measured"}.size() == itFile->uValuesBytes);
+        REQUIRE(0 == itFile->uBackupTreeBytes);
+        REQUIRE(itFile->uContentBytes > 0);
+        REQUIRE(itFile->uTotalBytes == emb::settings::get_file_memory_usage("BudgetFile"));
+        REQUIRE(stStats.uRegistryBytes > 0);
+        REQUIRE(stStats.uTotalBytes > stStats.uRegistryBytes);
+    }
+    SECTION("Changed files measured again when sampled") {
+        BudgetScalar::write("short");
+        auto const uShort = emb::settings::get_file_memory_usage("BudgetFile");
+        BudgetScalar::write(std::string(1000, 'x'));
+        REQUIRE(emb::settings::get_file_memory_usage("BudgetFile") > uShort + 1000);
+        BudgetScalar::reset();
+    }
+}
+
+TEST_CASE("Performance_counters") {
+    SECTION("Counters and histograms of a file") {
+        auto const budget_stats = [] {
+            auto const vecStats = emb::settings::stats();
+            return *std::find_if(vecStats.begin(), vecStats.end(),
+                [](emb::settings::FileStats const& a_stFile) { return "BudgetFile" == a_stFile.strFileName; });
+        };
+        BudgetScalar::write("counted");
+        auto const stBefore = budget_stats();
+        BudgetScalar::write("counted again");
+        BudgetScalar::write("counted again");
+        BudgetScalar::read();
+        BudgetScalar::reset();
+        auto const stAfter = budget_stats();
+        REQUIRE(stAfter.uResets == stBefore.uResets + 1);
+        REQUIRE(stAfter.uReads >= stBefore.uReads + 1);
+        REQUIRE(stAfter.uWrites >= stBefore.uWrites + 3);
+        REQUIRE(stAfter.uLocks == stAfter.uReads + stAfter.uWrites);
+        REQUIRE(stAfter.uSkippedWrites >= stBefore.uSkippedWrites + 1);
+        REQUIRE(stAfter.uBytesWritten > stBefore.uBytesWritten);
+        REQUIRE(stAfter.lockWaitHistogram.uCount == stAfter.uLocks);
+        REQUIRE(stAfter.serializeHistogram.uCount > stBefore.serializeHistogram.uCount);
+        REQUIRE(stAfter.diskWriteHistogram.uCount > stBefore.diskWriteHistogram.uCount);
+        REQUIRE(std::chrono::microseconds{1} == emb::settings::LatencyHistogram::bucket_upper_bound(0));
+    }
+}
+
+TEST_CASE("Contention_profiler") {
+    SECTION("Blocking pair of a read waiting for a view") {
+        BudgetScalar::write("profiled");
+        emb::settings::start_contention_profiler();
+        std::thread reader{};
+        {
+            auto const guard = BudgetFile::view();
+            reader = std::thread{ [] { BudgetScalar::read(); } };
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+        reader.join();
+        emb::settings::stop_contention_profiler();
+        auto const stReport = emb::settings::contention_report();
+        REQUIRE_FALSE(stReport.vecBlockingPairs.empty());
+        auto const& stWait = stReport.vecBlockingPairs.front();
+        REQUIRE("BudgetFile" == stWait.strFileName);
+        REQUIRE("view" == stWait.strHolder);
+        REQUIRE("BudgetScalar" == stWait.strWaiter);
+        REQUIRE(1 == stWait.uCount);
+        REQUIRE(stWait.max >= std::chrono::milliseconds{10});
+        REQUIRE(std::any_of(stReport.vecHolders.begin(), stReport.vecHolders.end(),
+            [](emb::settings::LockHold const& a_stHold) { return "view" == a_stHold.strHolder && a_stHold.total >= std::chrono::milliseconds{10}; }));
+        REQUIRE(std::string::npos != emb::settings::to_json(stReport).find("\"waiter\":\"BudgetScalar\""));
+    }
+}
+
+TEST_CASE("Tracing_spans") {
+    SECTION("Spans of a write and of a reload exported as Chrome trace events") {
+        auto pExporter = std::make_shared<emb::settings::ChromeTraceExporter>();
+        auto const has_span = [&pExporter](emb::settings::TraceSpanType a_eType) {
+            return std::string::npos != pExporter->to_json().find(std::string{ "{\"name\":\"" } + emb::settings::str(a_eType) + "\"");
+        };
+        BudgetScalar::write("untraced");
+        emb::settings::set_tracer(pExporter);
+        BudgetScalar::write("traced");
+        // Unloaded, then read again on next access
+        emb::settings::set_memory_budget(1);
+        REQUIRE("traced" == BudgetScalar::read());
+        emb::settings::set_memory_budget();
+        emb::settings::set_tracer();
+        BudgetScalar::write("untraced again");
+        std::string const strJson{ pExporter->to_json() };
+        REQUIRE(0 == strJson.find("{\"traceEvents\":[{\"name\":"));
+        REQUIRE(std::string::npos != strJson.find("\"ph\":\"X\""));
+        REQUIRE(std::string::npos != strJson.find("\"args\":{\"file\":\"BudgetFile\",\"bytes\":"));
+        REQUIRE(has_span(emb::settings::TraceSpanType::Serialize));
+        REQUIRE(has_span(emb::settings::TraceSpanType::Compare));
+        REQUIRE(has_span(emb::settings::TraceSpanType::DiskWrite));
+        REQUIRE(has_span(emb::settings::TraceSpanType::Flush));
+        REQUIRE(has_span(emb::settings::TraceSpanType::Load));
+        REQUIRE(has_span(emb::settings::TraceSpanType::Parse));
+        REQUIRE_FALSE(has_span(emb::settings::TraceSpanType::Migration));
+        pExporter->clear();
+        REQUIRE("{\"traceEvents\":[]}" == pExporter->to_json());
+    }
+}
+
+TEST_CASE("File_watcher") {
+    auto const reloads = [] {
+        auto const vecStats = emb::settings::stats();
+        return std::find_if(vecStats.begin(), vecStats.end(),
+            [](emb::settings::FileStats const& a_stFile) { return "WatchedFile" == a_stFile.strFileName; })->uReloads;
+    };
+    auto const write_externally = [](std::string const& a_strPath, std::string const& a_strValue) {
+        std::ofstream{ a_strPath } << "{\"watched\":{\"value\":\"" << a_strValue << "\"}}";
+    };
+    // Waits for a reload, the watcher thread being asynchronous
+    auto const wait_value = [](std::string const& a_strValue) {
+        for(int i = 0; i < 100 && a_strValue != WatchedScalar::read(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+        return a_strValue == WatchedScalar::read();
+    };
+    constexpr std::chrono::milliseconds debounce{100};
+    WatchedScalar::write("initial");
+    REQUIRE(emb::settings::start_file_watcher(debounce));
+    SECTION("Own writes not reloaded") {
+        auto const uReloads = reloads();
+        WatchedScalar::write("own write");
+        std::this_thread::sleep_for(3 * debounce);
+        REQUIRE(uReloads == reloads());
+        REQUIRE("own write" == WatchedScalar::read());
+    }
+    SECTION("External modification reloaded") {
+        write_externally("WatchedFile.json", "modified");
+        REQUIRE(wait_value("modified"));
+    }
+    SECTION("Replacement by a renamed file reloaded") {
+        write_externally("WatchedFile.json.tmp", "replaced");
+        REQUIRE(0 == std::rename("WatchedFile.json.tmp", "WatchedFile.json"));
+        REQUIRE(wait_value("replaced"));
+    }
+    SECTION("Events of successive modifications debounced") {
+        auto const uReloads = reloads();
+        for(int i = 0; i < 5; ++i) {
+            write_externally("WatchedFile.json", "burst " + std::to_string(i));
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+        REQUIRE(wait_value("burst 4"));
+        std::this_thread::sleep_for(2 * debounce);
+        REQUIRE(uReloads + 1 == reloads());
+    }
+    SECTION("Watcher stopped and restarted") {
+        emb::settings::stop_file_watcher();
+        write_externally("WatchedFile.json", "unwatched");
+        std::this_thread::sleep_for(3 * debounce);
+        REQUIRE("initial" == WatchedScalar::read());
+        REQUIRE(emb::settings::start_file_watcher(debounce));
+        write_externally("WatchedFile.json", "watched again");
+        REQUIRE(wait_value("watched again"));
+    }
+    SECTION("Unloaded file modified without changing its time and size read again from disk") {
+        {
+            // Large enough to be compacted when unloaded
+            auto pTree = emb::settings::internal::get_file_tree("WatchedFile", false);
+            for(int i = 0; i < 1000; ++i) {
+                pTree->put("filler.key" + std::to_string(i), i);
+            }
+        }
+        std::size_t uTotal{ 0 };
+        for(char const* szFile : { "File", "SidecarFile", "BudgetFile", "WatchedFile" }) {
+            uTotal += emb::settings::get_file_memory_usage(szFile);
+        }
+        Scalar::read();
+        StringScalar::read();
+        BudgetScalar::read();
+        emb::settings::set_memory_budget(uTotal - 1);
+        std::stringstream content{};
+        content << std::ifstream{ "WatchedFile.json" }.rdbuf();
+        std::string strContent{ content.str() };
+        strContent.replace(strContent.find("initial"), std::string{"initial"}.size(), "changed");
+        auto const writeTime = std::filesystem::last_write_time("WatchedFile.json");
+        std::ofstream{ "WatchedFile.json" } << strContent;
+        std::filesystem::last_write_time("WatchedFile.json", writeTime);
+        std::this_thread::sleep_for(3 * debounce);
+        emb::settings::set_memory_budget();
+        REQUIRE("changed" == WatchedScalar::read());
+        emb::settings::internal::get_file_tree("WatchedFile", false)->erase("filler");
+    }
+    emb::settings::stop_file_watcher();
+}